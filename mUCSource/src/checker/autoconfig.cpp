@@ -0,0 +1,224 @@
+#include "autoconfig.h"
+#include "mainsolver.h"
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <sstream>
+#include <stdlib.h>
+
+namespace car
+{
+    // the built-in table. The thresholds are picked on the HWMCC benchmarks, a table trained on others can be loaded by --auto-rules.
+    static const char *builtin_rules[] = {
+        // the probe already decided it, any setting will do.
+        "decided>=1 : imp=0 inter=0 rotate=0",
+        // few latches, frames stay small: the manual implication check is cheap enough.
+        "latches<64 : imp=0 inter=1 rotate=1 dir=b",
+        // long UCs of I: compute another UC each time, to converge faster. Large frames are checked by the solver.
+        "uc_ratio>=0.5 latches>=64 : imp=5 conv=0 param=1 inter=1 rotate=1 dir=b",
+        // expensive SAT calls: do not pay for the intersection.
+        "sat_us>=5000 : imp=5 inter=0 rotate=1 dir=b",
+        // the mUC setting otherwise.
+        ": imp=5 inter=1 rotate=1 dir=b",
+    };
+
+    bool InstanceFeatures::get(const std::string &name, double &val) const
+    {
+        if (name == "inputs")
+            val = inputs;
+        else if (name == "latches")
+            val = latches;
+        else if (name == "ands")
+            val = ands;
+        else if (name == "constraints")
+            val = constraints;
+        else if (name == "o0")
+            val = o0;
+        else if (name == "uc_len")
+            val = uc_len;
+        else if (name == "uc_ratio")
+            val = uc_ratio;
+        else if (name == "sat_us")
+            val = sat_us;
+        else if (name == "decided")
+            val = decided;
+        else
+            return false;
+        return true;
+    }
+
+    void InstanceFeatures::print(std::ostream &out) const
+    {
+        out << "auto features: inputs=" << inputs << " latches=" << latches << " ands=" << ands << " constraints=" << constraints
+            << " o0=" << o0 << " uc_len=" << uc_len << " uc_ratio=" << uc_ratio << " sat_us=" << sat_us << " decided=" << decided << std::endl;
+    }
+
+    void AutoChoice::print(std::ostream &out) const
+    {
+        out << "auto choice: imp=" << impMethod << " conv=" << convMode << " param=" << convParam << " inter=" << inter_cnt
+            << " rotate=" << rotate << " dir=" << (forward ? "f" : "b") << std::endl;
+    }
+
+    AutoConfig::AutoConfig()
+    {
+        for (const char *line : builtin_rules)
+        {
+            bool ok = parse_line(line, rules_);
+            assert(ok);
+        }
+    }
+
+    bool AutoConfig::load(const std::string &file)
+    {
+        std::ifstream in(file);
+        if (!in.is_open())
+            return false;
+        std::vector<Rule> rules;
+        std::string line;
+        while (std::getline(in, line))
+            if (!parse_line(line, rules))
+                return false;
+        rules_.swap(rules);
+        return true;
+    }
+
+    bool AutoConfig::parse_line(const std::string &line, std::vector<Rule> &rules) const
+    {
+        size_t first = line.find_first_not_of(" \t\r");
+        if (first == std::string::npos || line[first] == '#')
+            return true;
+        size_t colon = line.find(':');
+        if (colon == std::string::npos)
+            return false;
+
+        Rule rule;
+        std::stringstream conds(line.substr(0, colon));
+        std::string tok;
+        while (conds >> tok)
+        {
+            size_t pos = tok.find_first_of("<>=");
+            if (pos == std::string::npos || pos == 0)
+                return false;
+            size_t end = tok.find_first_not_of("<>=", pos);
+            if (end == std::string::npos)
+                return false;
+            Condition c{tok.substr(0, pos), tok.substr(pos, end - pos), atof(tok.c_str() + end)};
+            double dummy;
+            if (!InstanceFeatures().get(c.feature, dummy))
+                return false;
+            if (c.op != "<" && c.op != "<=" && c.op != ">" && c.op != ">=" && c.op != "=")
+                return false;
+            rule.conditions.push_back(c);
+        }
+
+        std::stringstream sets(line.substr(colon + 1));
+        while (sets >> tok)
+        {
+            size_t pos = tok.find('=');
+            if (pos == std::string::npos)
+                return false;
+            Setting s{tok.substr(0, pos), tok.substr(pos + 1)};
+            if (s.key != "imp" && s.key != "conv" && s.key != "param" && s.key != "inter" && s.key != "rotate" && s.key != "dir")
+                return false;
+            if (s.key == "dir" && s.value != "f" && s.value != "b")
+                return false;
+            rule.settings.push_back(s);
+        }
+        rules.push_back(rule);
+        return true;
+    }
+
+    bool AutoConfig::holds(const Condition &c, const InstanceFeatures &f)
+    {
+        double val = 0;
+        f.get(c.feature, val);
+        if (c.op == "<")
+            return val < c.value;
+        if (c.op == "<=")
+            return val <= c.value;
+        if (c.op == ">")
+            return val > c.value;
+        if (c.op == ">=")
+            return val >= c.value;
+        return val == c.value;
+    }
+
+    void AutoConfig::choose(const InstanceFeatures &f, AutoChoice &choice, int fixed) const
+    {
+        for (const Rule &rule : rules_)
+        {
+            if (!std::all_of(rule.conditions.begin(), rule.conditions.end(), [&f](const Condition &c)
+                             { return holds(c, f); }))
+                continue;
+            for (const Setting &s : rule.settings)
+            {
+                if (s.key == "imp" && !(fixed & AUTO_IMP))
+                    choice.impMethod = atoi(s.value.c_str());
+                else if (s.key == "conv" && !(fixed & AUTO_CONV))
+                    choice.convMode = atoi(s.value.c_str());
+                else if (s.key == "param" && !(fixed & AUTO_CONV))
+                    choice.convParam = atoi(s.value.c_str());
+                else if (s.key == "inter" && !(fixed & AUTO_INTER))
+                    choice.inter_cnt = atoi(s.value.c_str());
+                else if (s.key == "rotate" && !(fixed & AUTO_ROTATE))
+                    choice.rotate = atoi(s.value.c_str()) != 0;
+                else if (s.key == "dir" && !(fixed & AUTO_DIR))
+                    choice.forward = s.value == "f";
+            }
+            return;
+        }
+    }
+
+    /**
+     * @brief the immediate check of the checker, with ConvModeAlways: ask for a UC of I -> bad, and move its literals to the back,
+     * until a UC starts with a literal that was already met.
+     * @note The template solver of the model is built here, the checker copies it later.
+     */
+    InstanceFeatures AutoConfig::probe(Model *model, int rounds)
+    {
+        InstanceFeatures f;
+        f.inputs = model->num_inputs();
+        f.latches = model->num_latches();
+        f.ands = model->num_ands();
+        f.constraints = model->num_constraints();
+
+        MainSolver solver(model, 0, false, false);
+        int bad = model->output(0);
+        std::vector<int> latches = model->init();
+
+        int calls = 0;
+        long total_len = 0;
+        int last_max = 0;
+        auto begin = std::chrono::steady_clock::now();
+        while (calls < rounds)
+        {
+            ++calls;
+            if (solver.solve_with_assumption(latches, bad))
+            {
+                f.decided = true;
+                break;
+            }
+            Cube cu = solver.get_conflict_no_bad(bad);
+            if (cu.empty())
+            {
+                f.decided = true;
+                break;
+            }
+            if (abs(cu[0]) <= last_max)
+                break;
+            last_max = abs(cu[0]);
+            ++f.o0;
+            total_len += cu.size();
+            std::stable_partition(latches.begin(), latches.end(), [last_max](int x)
+                                  { return abs(x) > last_max; });
+        }
+        std::chrono::duration<double, std::micro> elapsed = std::chrono::steady_clock::now() - begin;
+
+        f.sat_us = elapsed.count() / calls;
+        if (f.o0 > 0)
+            f.uc_len = double(total_len) / f.o0;
+        if (f.latches > 0)
+            f.uc_ratio = f.uc_len / f.latches;
+        return f;
+    }
+}
@@ -0,0 +1,104 @@
+#ifndef AUTO_CONFIG_H
+#define AUTO_CONFIG_H
+
+#include "model.h"
+#include <string>
+#include <vector>
+#include <ostream>
+
+namespace car
+{
+    /**
+     * @brief cheap features of an instance, collected before the search starts.
+     * The static ones are read from the model, the others come from a short probe that repeats the immediate check of I with the main solver.
+     */
+    struct InstanceFeatures
+    {
+        int inputs = 0;
+        int latches = 0;
+        int ands = 0;
+        int constraints = 0;
+        // number of UCs the probe found for I, that is, the size of Onp[0] with ConvModeAlways.
+        int o0 = 0;
+        // average length of those UCs, and its ratio to the number of latches.
+        double uc_len = 0;
+        double uc_ratio = 0;
+        // average time of a main solver call in the probe, in microseconds.
+        double sat_us = 0;
+        // the probe already decided the instance: I reaches bad, or bad is UNSAT.
+        bool decided = false;
+
+        // the value of a feature by its name in the rule table. Return false if the name is unknown.
+        bool get(const std::string &name, double &val) const;
+        void print(std::ostream &out) const;
+    };
+
+    // the options that --auto chooses.
+    struct AutoChoice
+    {
+        int impMethod = 0;
+        int convMode = -1;
+        int convParam = 0;
+        int inter_cnt = 0;
+        bool rotate = false;
+        bool forward = false;
+
+        void print(std::ostream &out) const;
+    };
+
+    // bits of the options given on the command line, --auto does not change them.
+    enum AutoOption
+    {
+        AUTO_IMP = 1,
+        AUTO_CONV = 2,
+        AUTO_INTER = 4,
+        AUTO_ROTATE = 8,
+        AUTO_DIR = 16
+    };
+
+    /**
+     * @brief An ordered rule table, the first rule whose conditions all hold is applied.
+     * One rule per line, conditions and settings are separated by ':'
+     *      latches<64 uc_ratio>=0.5 : imp=0 conv=0 param=1 inter=1 rotate=1 dir=b
+     * Conditions are `<feature><op><value>` with op in <, <=, >, >=, =. A rule without conditions always holds.
+     * Settings are imp, conv, param, inter, rotate (0/1) and dir (f/b). Lines starting with '#' are comments.
+     * The built-in table is used unless a table trained offline is loaded.
+     */
+    class AutoConfig
+    {
+    public:
+        AutoConfig();
+        // replace the table by the one in the file. Return false if it cannot be read or parsed.
+        bool load(const std::string &file);
+
+        // the choice for the instance. The options in `fixed` (AutoOption bits) keep their value in `choice`.
+        void choose(const InstanceFeatures &f, AutoChoice &choice, int fixed) const;
+
+        // probe the instance. `rounds` limits the number of main solver calls.
+        static InstanceFeatures probe(Model *model, int rounds = 16);
+
+    private:
+        struct Condition
+        {
+            std::string feature;
+            std::string op;
+            double value;
+        };
+        struct Setting
+        {
+            std::string key;
+            std::string value;
+        };
+        struct Rule
+        {
+            std::vector<Condition> conditions;
+            std::vector<Setting> settings;
+        };
+        std::vector<Rule> rules_;
+
+        bool parse_line(const std::string &line, std::vector<Rule> &rules) const;
+        static bool holds(const Condition &c, const InstanceFeatures &f);
+    };
+}
+
+#endif
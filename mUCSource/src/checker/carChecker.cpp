@@ -21,23 +21,31 @@ namespace car
 {
     // increase one each time. monotonous
     int storage_id = 0;
-    static vector<Cube> reorderAssum(const vector<Cube>& inter, const Cube &rres, const Cube &rtmp);
+    static vector<Cube> reorderAssum(const vector<Cube>& inter, const Cube &rres, const Cube &rtmp, AssumOrder order);
+    // the order of the UCs to keep: the more active first, then the shorter.
+    static bool moreActive(const UC &a, const UC &b)
+    {
+        return a.activity() != b.activity() ? a.activity() > b.activity() : a.size() < b.size();
+    }
 
-    Checker::Checker(Model *model, std::ostream &out, std::ofstream &trail_out, std::ofstream &dot_out, std::ofstream &dive_out, bool enable_dive, bool forward, bool evidence, int index_to_check,int convMode, int convParam, bool enable_rotate, int inter_cnt, bool inv_incomplete, bool uc_no_sort, int impMethod) : model_(model), out(out), dot_out(dot_out), dive_out(dive_out), enable_dive(enable_dive), evidence_(evidence),  trail_out(trail_out), convMode(convMode), convParam(convParam), rotate_enabled(enable_rotate), inter_cnt(inter_cnt), inv_incomplete(inv_incomplete), uc_no_sort(uc_no_sort), impMethod(impMethod)
+    void Checker::init(bool forward, int index_to_check)
     {
-        // TODO: use propagate to accelerate
         backward_first = !forward;
-        bad_ = model->output(index_to_check);
-        bi_main_solver = new MainSolver(model,get_rotate(),false,uc_no_sort);
-        #ifdef INC_SAT
-        bi_main_solver->setIncrementalMode();
-        #endif // INC_SAT
+        bad_ = model_->output(index_to_check);
+        bi_main_solver = new MainSolver(model_,get_rotate(),false,uc_no_sort);
+        bi_main_solver->set_uc_order(strategy_.last_first, strategy_.front_flag);
+        if (strategy_.inc_sat)
+            bi_main_solver->set_incremental_mode();
+        if (strategy_.div_workers > 0 && convMode >= 0)
+            uc_div = new UCDiversifier(bi_main_solver, model_, get_rotate(), uc_no_sort, strategy_.last_first, strategy_.front_flag, strategy_.div_workers);
+        if (strategy_.mic_async > 0)
+            uc_str = new UCStrengthener(bi_main_solver, model_, get_rotate(), uc_no_sort, strategy_.last_first, strategy_.front_flag, strategy_.mic_async, strategy_.mic_budget);
         if(!backward_first)
         {
             // only forward needs these
-            bi_partial_solver = new PartialSolver(model);
+            bi_partial_solver = new PartialSolver(model_);
             // TODO: extend to multi-properties.
-            bi_start_solver = new StartSolver(model, bad_, true);
+            bi_start_solver = new StartSolver(model_, bad_, true);
         }
         else{
             bi_partial_solver = nullptr;
@@ -52,79 +60,49 @@ namespace car
         rotate.clear();
         score_dicts.clear();
         score_dict.clear();
+        select_policy();
+        stuck_detector = StuckDetector(convParam);
+        restart_policy = RestartPolicy(strategy_.restart_kind, strategy_.restart_unit);
+    }
+
+    Checker::Checker(Model *model, std::ostream &out, std::ofstream &trail_out, std::ofstream &dot_out, std::ofstream &dive_out, bool enable_dive, bool forward, bool evidence, int index_to_check,int convMode, int convParam, bool enable_rotate, int inter_cnt, bool inv_incomplete, bool uc_no_sort, int impMethod, const Strategy &strategy) : model_(model), out(out), dot_out(dot_out), dive_out(dive_out), enable_dive(enable_dive), evidence_(evidence),  trail_out(trail_out), convMode(convMode), convParam(convParam), rotate_enabled(enable_rotate), inter_cnt(inter_cnt), inv_incomplete(inv_incomplete), uc_no_sort(uc_no_sort), impMethod(impMethod), strategy_(strategy)
+    {
+        init(forward, index_to_check);
         restart_enabled = false;
         importO = false;
     }
 
-    Checker::Checker(int time_limit, Model *model, std::ostream &out, std::ofstream &trail_out, std::ofstream &dot_out, std::ofstream &dive_out, bool enable_dive, bool forward, bool evidence, int index_to_check,int convMode, int convParam, bool enable_rotate, int inter_cnt, bool inv_incomplete, bool uc_no_sort, int impMethod) : model_(model), out(out), dot_out(dot_out), dive_out(dive_out), enable_dive(enable_dive), evidence_(evidence),  trail_out(trail_out), convMode(convMode), convParam(convParam), rotate_enabled(enable_rotate), inter_cnt(inter_cnt), inv_incomplete(inv_incomplete), uc_no_sort(uc_no_sort), impMethod(impMethod), time_limit_to_restart(time_limit)
+    Checker::Checker(int time_limit, Model *model, std::ostream &out, std::ofstream &trail_out, std::ofstream &dot_out, std::ofstream &dive_out, bool enable_dive, bool forward, bool evidence, int index_to_check,int convMode, int convParam, bool enable_rotate, int inter_cnt, bool inv_incomplete, bool uc_no_sort, int impMethod, const Strategy &strategy) : model_(model), out(out), dot_out(dot_out), dive_out(dive_out), enable_dive(enable_dive), evidence_(evidence),  trail_out(trail_out), convMode(convMode), convParam(convParam), rotate_enabled(enable_rotate), inter_cnt(inter_cnt), inv_incomplete(inv_incomplete), uc_no_sort(uc_no_sort), impMethod(impMethod), strategy_(strategy), time_limit_to_restart(time_limit)
     {
-        // TODO: use propagate to accelerate
-        backward_first = !forward;
-        bad_ = model->output(index_to_check);
-        bi_main_solver = new MainSolver(model,get_rotate(),false,uc_no_sort);
-        #ifdef INC_SAT
-        bi_main_solver->setIncrementalMode();
-        #endif // INC_SAT
-        if(!backward_first)
-        {
-            // only forward needs these
-            bi_partial_solver = new PartialSolver(model);
-            // TODO: extend to multi-properties.
-            bi_start_solver = new StartSolver(model, bad_, true);
-        }
-        else{
-            bi_partial_solver = nullptr;
-            bi_start_solver = nullptr;
-        }
-        if (enable_dive)
-        {
-            assert(dive_out.is_open());
-            dive_draw_head();
-        }
-        rotates.clear();
-        rotate.clear();
-        score_dicts.clear();
-        score_dict.clear();
+        init(forward, index_to_check);
         restart_enabled = true;
         importO = false;
     }
 
-    Checker::Checker(int time_limit, Checker* last_chker, int rememOption, Model *model, std::ostream &out, std::ofstream &trail_out, std::ofstream &dot_out, std::ofstream &dive_out, bool enable_dive, bool forward, bool evidence, int index_to_check,int convMode, int convParam, bool enable_rotate, int inter_cnt, bool inv_incomplete, bool uc_no_sort, int impMethod) : model_(model), out(out), dot_out(dot_out), dive_out(dive_out), enable_dive(enable_dive), evidence_(evidence),  trail_out(trail_out), convMode(convMode), convParam(convParam), rotate_enabled(enable_rotate), inter_cnt(inter_cnt), inv_incomplete(inv_incomplete), uc_no_sort(uc_no_sort), impMethod(impMethod), time_limit_to_restart(time_limit), last_chker(last_chker), rememOption(rememOption)
+    Checker::Checker(int time_limit, Checker* last_chker, int rememOption, Model *model, std::ostream &out, std::ofstream &trail_out, std::ofstream &dot_out, std::ofstream &dive_out, bool enable_dive, bool forward, bool evidence, int index_to_check,int convMode, int convParam, bool enable_rotate, int inter_cnt, bool inv_incomplete, bool uc_no_sort, int impMethod, const Strategy &strategy) : model_(model), out(out), dot_out(dot_out), dive_out(dive_out), enable_dive(enable_dive), evidence_(evidence),  trail_out(trail_out), convMode(convMode), convParam(convParam), rotate_enabled(enable_rotate), inter_cnt(inter_cnt), inv_incomplete(inv_incomplete), uc_no_sort(uc_no_sort), impMethod(impMethod), strategy_(strategy), time_limit_to_restart(time_limit), last_chker(last_chker), rememOption(rememOption)
     {
-        // TODO: use propagate to accelerate
-        backward_first = !forward;
-        bad_ = model->output(index_to_check);
-        bi_main_solver = new MainSolver(model,get_rotate(),false,uc_no_sort);
-        #ifdef INC_SAT
-        bi_main_solver->setIncrementalMode();
-        #endif // INC_SAT
-        if(!backward_first)
-        {
-            // only forward needs these
-            bi_partial_solver = new PartialSolver(model);
-            // TODO: extend to multi-properties.
-            bi_start_solver = new StartSolver(model, bad_, true);
-        }
-        else{
-            bi_partial_solver = nullptr;
-            bi_start_solver = nullptr;
-        }
-        if (enable_dive)
-        {
-            assert(dive_out.is_open());
-            dive_draw_head();
-        }
-        rotates.clear();
-        rotate.clear();
-        score_dicts.clear();
-        score_dict.clear();
+        init(forward, index_to_check);
+        // the next interval of the schedule.
+        restart_policy = last_chker->restart_policy;
         restart_enabled = true;
         importO = true;
     }
 
     Checker::~Checker()
     {
+        // it refers to the O sequences.
+        delete uc_str;
+        uc_str = nullptr;
+        // the flags of the O sequences are those of this main solver. The checker of the next restart may get an O sequence at the same address.
+        auto &flags = MainSolver::flag_of_O;
+        flags.erase(&Onp);
+        flags.erase(&OI);
+        for (auto &os : SO_map)
+            flags.erase(os.second);
         clean();
+        // it refers to the main solver.
+        delete uc_div;
+        uc_div = nullptr;
         if (bi_main_solver)
         {
             delete bi_main_solver;
@@ -215,7 +193,7 @@ namespace car
             Osequence &O = direction ? OI : Onp;
             LOG("Bi-Target:" << (direction ? "I" : "~P"));
 
-            if (trySAT(U, &O, direction, res))
+            if ((this->*try_sat_)(U, &O, direction, res))
             {
                 // if this PP phase ends, but has not reached the whole end.
                 if (ppstoped)
@@ -226,6 +204,12 @@ namespace car
                 return res;
             }
 
+            if (strategy_.propagate)
+                propagate(&O);
+
+            if (long target = reduceTarget(&O))
+                reduceFrames(&O, target);
+
             if (!inv_incomplete)
             {
                 if (InvFound(&O))
@@ -282,6 +266,18 @@ namespace car
         return false;
     }
 
+    /**
+     * @brief pick the specialization of trySAT() for the strategy. It is the only place where the policy is dispatched.
+     */
+    void Checker::select_policy()
+    {
+        if (strategy_.pqueue)
+            try_sat_ = strategy_.score ? &Checker::trySAT<SearchPolicy<true, true>> : &Checker::trySAT<SearchPolicy<true, false>>;
+        else
+            try_sat_ = strategy_.score ? &Checker::trySAT<SearchPolicy<false, true>> : &Checker::trySAT<SearchPolicy<false, false>>;
+    }
+
+    template <class Policy>
     bool Checker::trySAT(Usequence &U, Osequence *O, bool forward, bool &safe_reported)
     {
         // NOTE: can eliminate initialization.
@@ -293,16 +289,23 @@ namespace car
          * this procedure is like the old car procedure, but the Osequence is not bound to be OI or Onegp.
          * @param missionary the state to be checked
          */
-        while (State *missionary = pickState(U))
+        while (true)
         {
+            if (strategy_.batch_states > 1)
+                batchQuery(U, O, Otmp);
+            State *missionary = pickState(U);
+            if (!missionary)
+                break;
             LOG("Pick " << missionary->id);
             /**
              * build a stack <state, depth, target_level>
              */
-            CONTAINER stk;
+            typename Policy::Container stk;
             stk.push(item(missionary, 0, O->size() - 1));
             while (!stk.empty())
             {
+                if (uc_str && uc_str->ready())
+                    collectStrengthened(O, Otmp);
                 CARStats.count_enter_new_try_by();
                 State *s;
                 int dst, depth;
@@ -313,6 +316,8 @@ namespace car
                     // TODO: memorize state's blocking status. Since we do not remove UC, once blocked, forever blocked.
                     stk.pop();
                     CARStats.count_tried_before();
+                    if (convMode == ConvModeStuck)
+                        stuck_detector.blocked(dst + 1);
                     LOG("Tried before");
                     direct_blocked_counter++;
                     blocked_ids.insert(s->id);
@@ -333,39 +338,83 @@ namespace car
 
                 if (restart_enabled)
                 {
-                    auto now = steady_clock::now();
-                    duration_high elapsed = now - sat_timer;
-                    double time_delay = elapsed.count();
-                    if (time_delay > time_limit_to_restart * 1000)
+                    bool due;
+                    if (restart_policy.kind() == Restart_Time)
                     {
-                        ppstoped = true;
-                        return true;
+                        auto now = steady_clock::now();
+                        duration_high elapsed = now - sat_timer;
+                        double time_delay = elapsed.count();
+                        due = time_delay > time_limit_to_restart * 1000;
+                    }
+                    else
+                        // each try that gets here makes a query.
+                        due = restart_policy.tick();
+                    if (due)
+                    {
+                        if (!strategy_.warm_restart)
+                        {
+                            ppstoped = true;
+                            return true;
+                        }
+                        warmRestart();
                     }
                 }
 
-                if (satAssume(bi_main_solver, O, s, dst, Otmp, safe_reported))
+                State *tprime = nullptr;
+                if (s == batch_hit.first && dst == O->size() - 1)
+                    tprime = batch_hit.second;
+                else if (strategy_.reuse_successor && dst > -1)
+                    tprime = reusedSuccessor(s, dst, O, Otmp);
+                batch_hit = {nullptr, nullptr};
+                if (tprime || satAssume<Policy>(bi_main_solver, O, s, dst, Otmp, safe_reported))
                 {
                     LOG("Succeed");
                     if (dst == -1)
                     {
                         return true;
                     }
-                    State *tprime = getModel(bi_main_solver);
-                    LOG("Get " << tprime->id << " " << dst);
-
-                    updateU(U, tprime, s);
-
-                    // NOTE: why here calculate minNOTBLOCKED, rather than next time when pop?
-                    #ifdef DEPTH
-                    int new_level = minNOTBlocked(tprime, max(0, int(O->size()-1-depth)), dst - 1, O, Otmp);
-                    #else
-                    int new_level = minNOTBlocked(tprime, 0, dst - 1, O, Otmp);               
-                    #endif
-                    if (new_level <= dst) // if even not one step further, should not try it
+                    // the states to try next, the last one first.
+                    vector<State *> found;
+                    if (tprime)
                     {
-                        stk.push(item(tprime, depth + 1, new_level - 1));
-                        LOG("Jump " << dst << " " << new_level - 1);
-                        DIVE_DRAW(s, dst + 1, tprime, new_level, (O_level_repeat[dst] != s->id ? 0 : 3), O_level_repeat[dst] == s->id ? O_level_repeat_counter[dst] + 1 : 0);
+                        LOG("Reuse " << tprime->id << " " << dst);
+                    }
+                    else
+                    {
+                        tprime = getModel(bi_main_solver);
+                        LOG("Get " << tprime->id << " " << dst);
+
+                        updateU(U, tprime, s);
+                        // a partial state may hold states that are blocked, only a full one is a witness by itself.
+                        if (strategy_.reuse_successor && tprime->size() == model_->num_latches())
+                            successors[s] = tprime;
+
+                        if (strategy_.batch_successors > 1)
+                        {
+                            vector<State *> more;
+                            bi_main_solver->get_more_states(more, tprime, strategy_.batch_successors - 1, forward);
+                            CARStats.count_batch(more.size());
+                            for (auto it = more.rbegin(); it != more.rend(); ++it)
+                            {
+                                clear_defer(*it);
+                                LOG("Get " << (*it)->id << " " << dst);
+                                updateU(U, *it, s);
+                                found.push_back(*it);
+                            }
+                        }
+                    }
+                    found.push_back(tprime);
+
+                    for (State *t : found)
+                    {
+                        // NOTE: why here calculate minNOTBLOCKED, rather than next time when pop?
+                        int new_level = minNOTBlocked(t, strategy_.depth ? max(0, int(O->size()-1-depth)) : 0, dst - 1, O, Otmp);
+                        if (new_level <= dst) // if even not one step further, should not try it
+                        {
+                            stk.push(item(t, depth + 1, new_level - 1));
+                            LOG("Jump " << dst << " " << new_level - 1);
+                            DIVE_DRAW(s, dst + 1, t, new_level, (O_level_repeat[dst] != s->id ? 0 : 3), O_level_repeat[dst] == s->id ? O_level_repeat_counter[dst] + 1 : 0);
+                        }
                     }
                 }
                 else
@@ -400,9 +449,8 @@ namespace car
         direct_blocked_counter = 0;
         if (rotate_enabled)
             rotates.push_back(rotate);
-#ifdef SCORE
-        score_dicts.push_back(score_dict);
-#endif // SCORE
+        if (Policy::score)
+            score_dicts.push_back(score_dict);
         bi_main_solver->add_new_frame(Otmp, O->size() - 1, O, forward);
         PRINTIF_PROOF();
         return false;
@@ -742,135 +790,102 @@ namespace car
         return true;
     }
 
-    static vector<Cube> reorderAssum(const vector<Cube>& inter, const Cube &rres, const Cube &rtmp)
+    static vector<Cube> reorderAssum(const vector<Cube>& inter, const Cube &rres, const Cube &rtmp, AssumOrder order)
     {
-        vector<Cube> pref;
-#if defined(ASS_IRRI)
-        pref = inter;
-        if (pref.size() == 0)
-        {
-            pref = {rres, rtmp};
-        }
-        else
-        {
-            pref.insert(pref.begin() + 1, rres);
-            pref.insert(pref.begin() + 2, rtmp);
-        }
-#ifdef PRINT_ASS
-        cerr << "IRRI:" << endl;
-        for (auto &cu : pref)
-            for (int i : cu)
-                cerr << i << ", ";
-        cerr << endl;
-#endif
-#elif defined(ASS_IIRR)
-        pref = inter;
-        if (pref.size() == 0)
-        {
-            pref = {rres, rtmp};
-        }
-        else if (pref.size() == 1)
-        {
-            pref.insert(pref.begin() + 1, rres);
-            pref.insert(pref.begin() + 2, rtmp);
-        }
-        else
-        {
-            pref.insert(pref.begin() + 2, rres);
-            pref.insert(pref.begin() + 3, rtmp);
-        }
-#ifdef PRINT_ASS
-        cerr << "IIRR:" << endl;
-        for (auto &cu : pref)
-            for (int i : cu)
-                cerr << i << ", ";
-        cerr << endl;
-#endif
-#elif defined(ASS_IRIR)
-        pref = inter;
-        if (pref.size() == 0)
-        {
-            pref = {rres, rtmp};
-        }
-        else if (pref.size() == 1)
-        {
-            pref.insert(pref.begin() + 1, rres);
-            pref.insert(pref.begin() + 2, rtmp);
-        }
-        else
-        {
-            pref.insert(pref.begin() + 1, rres);
-            pref.insert(pref.begin() + 3, rtmp);
-        }
-#ifdef PRINT_ASS
-        cerr << "IRIR:" << endl;
-        for (auto &cu : pref)
-            for (int i : cu)
-                cerr << i << ", ";
-        cerr << endl;
-#endif
-#elif defined(ASS_RIRI)
-        pref = inter;
-        if (pref.size() == 0)
-        {
-            pref = {rres, rtmp};
-        }
-        else
-        {
-            pref.insert(pref.begin() + 0, rres);
-            pref.insert(pref.begin() + 2, rtmp);
-        }
-#ifdef PRINT_ASS
-        cerr << "RIRI:" << endl;
-        for (auto &cu : pref)
-            for (int i : cu)
-                cerr << i << ", ";
-        cerr << endl;
-#endif
-#elif defined(ASS_RRII)
-        pref = inter;
-        pref.insert(pref.begin() + 0, rres);
-        pref.insert(pref.begin() + 1, rtmp);
-#ifdef PRINT_ASS
-        cerr << "RRII:" << endl;
-        for (auto &cu : pref)
-            for (int i : cu)
-                cerr << i << ", ";
-        cerr << endl;
-#endif
-#elif defined(ASS_RIIR)
-        pref = inter;
-        if (pref.size() == 0)
-        {
-            pref = {rres, rtmp};
-        }
-        else if (pref.size() == 1)
-        {
-            pref.insert(pref.begin() + 0, rres);
-            pref.insert(pref.begin() + 2, rres);
-        }
-        else
+        vector<Cube> pref = inter;
+        switch (order)
         {
+        case Ass_IRRI:
+            if (pref.size() == 0)
+            {
+                pref = {rres, rtmp};
+            }
+            else
+            {
+                pref.insert(pref.begin() + 1, rres);
+                pref.insert(pref.begin() + 2, rtmp);
+            }
+            break;
+        case Ass_IIRR:
+            if (pref.size() == 0)
+            {
+                pref = {rres, rtmp};
+            }
+            else if (pref.size() == 1)
+            {
+                pref.insert(pref.begin() + 1, rres);
+                pref.insert(pref.begin() + 2, rtmp);
+            }
+            else
+            {
+                pref.insert(pref.begin() + 2, rres);
+                pref.insert(pref.begin() + 3, rtmp);
+            }
+            break;
+        case Ass_IRIR:
+            if (pref.size() == 0)
+            {
+                pref = {rres, rtmp};
+            }
+            else if (pref.size() == 1)
+            {
+                pref.insert(pref.begin() + 1, rres);
+                pref.insert(pref.begin() + 2, rtmp);
+            }
+            else
+            {
+                pref.insert(pref.begin() + 1, rres);
+                pref.insert(pref.begin() + 3, rtmp);
+            }
+            break;
+        case Ass_RIRI:
+            if (pref.size() == 0)
+            {
+                pref = {rres, rtmp};
+            }
+            else
+            {
+                pref.insert(pref.begin() + 0, rres);
+                pref.insert(pref.begin() + 2, rtmp);
+            }
+            break;
+        case Ass_RRII:
             pref.insert(pref.begin() + 0, rres);
-            pref.insert(pref.begin() + 3, rtmp);
+            pref.insert(pref.begin() + 1, rtmp);
+            break;
+        case Ass_RIIR:
+            if (pref.size() == 0)
+            {
+                pref = {rres, rtmp};
+            }
+            else if (pref.size() == 1)
+            {
+                pref.insert(pref.begin() + 0, rres);
+                pref.insert(pref.begin() + 2, rres);
+            }
+            else
+            {
+                pref.insert(pref.begin() + 0, rres);
+                pref.insert(pref.begin() + 3, rtmp);
+            }
+            break;
+        default:
+            pref.push_back(rres);
+            pref.push_back(rtmp);
+            break;
         }
 #ifdef PRINT_ASS
-        cerr << "RIIR:" << endl;
+        cerr << "assumption order " << order << ":" << endl;
         for (auto &cu : pref)
             for (int i : cu)
                 cerr << i << ", ";
         cerr << endl;
 #endif
 
-#else
-        pref = inter;
-        pref.push_back(rres);
-        pref.push_back(rtmp);
-#endif
-
         return pref;
     }
 
+    template <class Policy>
     bool Checker::satAssume(MainSolver *solver, Osequence *O, State *s, int level, Frame &Otmp, bool& safe_reported)
     {
         bool forward = !backward_first;
@@ -929,14 +944,12 @@ namespace car
                         inter_next = s->intersect(last_uc);
 
                         // otherwise, do not do this!
-                        #ifdef LAST_FIRST
-                        if (inter_next.size() > 1)
+                        if (strategy_.last_first && inter_next.size() > 1)
                         {
                             // insert the last bit to the front.
                             inter_next.insert(inter_next.begin(), inter_next.back());
                             inter_next.pop_back();
                         }
-                        #endif
                         inter.push_back(inter_next);
                         ++index;
                     }
@@ -1001,9 +1014,8 @@ namespace car
             } while (0);
 
             
-            do
+            if (Policy::score)
             {
-            #ifdef SCORE
                 // use score to order the state
 
                 // reference to the dict.
@@ -1012,7 +1024,8 @@ namespace car
                 // first assign to the original order.
                 score_order = s->s();
 
-                #ifdef SCORE_REVERSE
+                if (strategy_.score_reverse)
+                {
                     // from low to high, for sanity check check.
                     std::sort(score_order.begin(), score_order.end(), [&](const int &a, const int &b)
                     {
@@ -1024,7 +1037,9 @@ namespace car
                     {
                         return false;
                     } });
-                #else
+                }
+                else
+                {
                     // then sort according to the score.
                     // high -> low
                     // tie : ignore
@@ -1042,23 +1057,23 @@ namespace car
                         // at present: do not change it.
                         return false;
                     } });
-                #endif
+                }
 
                 // cerr<<"state: ";
                 // for(int i:score_order)
                 // cerr<<i<<"("<<dict_ref[i]<<"), ";
                 // cerr<<endl;
+            }
 
-            #endif
-            } while (0);
-
-            #ifdef SCORE
-                    // NOTE: rotate and score are contradictory, because they both contain the whole state.
-                    vector<Cube> pref = inter;
-                    pref.push_back(score_order);
-            #else
-                    vector<Cube> pref = reorderAssum(inter, rres, rtmp);
-            #endif
+            vector<Cube> pref;
+            if (Policy::score)
+            {
+                // NOTE: rotate and score are contradictory, because they both contain the whole state.
+                pref = inter;
+                pref.push_back(score_order);
+            }
+            else
+                pref = reorderAssum(inter, rres, rtmp, strategy_.ass_order);
 
             solver->set_assumption(O, s, level, forward, pref);
             CARStats.count_main_solver_original_time_start();
@@ -1080,7 +1095,15 @@ namespace car
             }
             CARStats.count_main_solver_original_time_end(res,uc.size());
 
+            if (strategy_.mic_attempts > 0 && level > -1 && uc.size() > 1)
+                generalize(solver, O, level, uc);
+
             addUCtoSolver(uc, O, level + 1, Otmp);
+            if (uc_str && level > -1 && uc.size() > 1)
+            {
+                uc_str->submit(O, level, uc, !backward_first);
+                CARStats.count_async_submit();
+            }
         }
 
         if (get_rotate() && !res)
@@ -1091,55 +1114,45 @@ namespace car
             rcu.insert(rcu.end(), rtmp.begin(), rtmp.end());
         }
 
-#ifdef SCORE
-        if (!res)
+        if (Policy::score && !res)
         {
             std::unordered_map<int, int> &dict_ref = level + 1 < score_dicts.size() ? score_dicts[level + 1] : score_dict;
 
-    #ifdef SCORE_DECAY
-            // multiplicative decay
-            if (decayCounter[level + 1] == 0)
+            if (strategy_.score_decay)
             {
-                // Magic Number 20.
-                decayCounter[level + 1] = 20;
+                // multiplicative decay
+                if (decayCounter[level + 1] == 0)
+                {
+                    // Magic Number 20.
+                    decayCounter[level + 1] = 20;
 
-                if (decayStep[level + 1] == 0)
-                    decayStep[level + 1] = 1000;
-                else
-                    decayStep[level + 1] *= 1.01;
+                    if (decayStep[level + 1] == 0)
+                        decayStep[level + 1] = 1000;
+                    else
+                        decayStep[level + 1] *= 1.01;
 
-                // to avoid overflow
-                if (decayStep[level + 1] > 1000000000)
-                {
-                    auto &dict = score_dicts[level + 1];
-                    for (auto &pair : dict)
+                    // to avoid overflow
+                    if (decayStep[level + 1] > 1000000000)
                     {
-                        pair.second >>= 28;
+                        auto &dict = score_dicts[level + 1];
+                        for (auto &pair : dict)
+                        {
+                            pair.second >>= 28;
+                        }
+                        decayStep[level + 1] = 1000;
                     }
-                    decayStep[level + 1] = 1000;
                 }
-            }
-            decayCounter[level + 1]--;
+                decayCounter[level + 1]--;
 
-            // plus bumping
-            for (auto &lit : s->s())
-            {
-    #ifdef SCORE_ABS
-                dict_ref[abs(lit)] += decayStep[level + 1];
-    #else
-                dict_ref[lit] += decayStep[level + 1];
-    #endif
+                // plus bumping
+                for (auto &lit : s->s())
+                    dict_ref[strategy_.score_abs ? abs(lit) : lit] += decayStep[level + 1];
             }
-    #else
-            for (auto &lit : s->s())
+            else
             {
-    #ifdef SCORE_ABS
-                dict_ref[abs(lit)]++;
-    #else
-                dict_ref[lit]++;
-    #endif
+                for (auto &lit : s->s())
+                    dict_ref[strategy_.score_abs ? abs(lit) : lit]++;
             }
-    #endif
             // cerr<<"state:";
             // for(int i:s->s())
             // cerr<<i<<", ";
@@ -1153,7 +1166,7 @@ namespace car
             // TODO: As to those appear in UC, should we add more scores?
         }
 
-#endif // !SCORE
+
 
         if(convMode >= 0)
         {
@@ -1238,7 +1251,10 @@ namespace car
                 }
                 case ConvModeStuck:
                 {
-                    // TODO: fill in here.
+                    stuck_detector.query(level + 1, !res, s->id);
+                    trigger = !res && stuck_detector.stuck(level + 1);
+                    if (trigger)
+                        CARStats.record_stuck(level + 1);
                     break;
                 }
 
@@ -1256,7 +1272,23 @@ namespace car
 
                 CARStats.count_main_solver_convergence_time_start();
                 // get another conflict!
-                auto nextuc = solver->get_conflict_another(!backward_first);
+                Cube nextuc;
+                if (uc_div)
+                {
+                    // the shortest of the UCs of the main solver and its clones, solved at once.
+                    vector<Cube> ucs;
+                    uc_div->diversify(!backward_first, ucs);
+                    // an empty UC is a candidate too, the shortest one.
+                    bool found = false;
+                    for (auto &cu : ucs)
+                        if (!found || cu.size() < nextuc.size())
+                        {
+                            nextuc = std::move(cu);
+                            found = true;
+                        }
+                }
+                else
+                    nextuc = solver->get_conflict_another(!backward_first);
                 CARStats.count_main_solver_convergence_time_end(nextuc.size());
                 //TODO: analyse, whether imply or implied.
 
@@ -1269,6 +1301,290 @@ namespace car
         return res;
     }
 
+    void Checker::generalize(MainSolver *solver, Osequence *O, int level, Cube &uc)
+    {
+        CARStats.count_generalize_begin();
+        int len_before = uc.size();
+        vector<int> query = solver->get_assumption();
+        int attempts = solver->shrink_uc(solver->flag_of(O, level), uc, !backward_first, strategy_.mic_attempts, strategy_.mic_budget);
+        solver->load_assumption(query);
+        CARStats.count_generalize_end(level + 1, attempts, len_before, uc.size());
+    }
+
+    void Checker::collectStrengthened(Osequence *O, Frame &Otmp)
+    {
+        std::vector<UCStrengthener::Result> res;
+        uc_str->collect(res);
+        CARStats.count_async_dropped(uc_str->take_dropped());
+        for (auto &r : res)
+        {
+            Osequence *o = r.O;
+            if (r.dst > o->size() || (r.dst == o->size() && o != O))
+            {
+                CARStats.count_async_stale();
+                continue;
+            }
+            Frame &frame = (r.dst < o->size()) ? (*o)[r.dst] : Otmp;
+            // the clauses of the retired UCs stay in the solvers, where they are implied by the new one.
+            Frame kept;
+            kept.reserve(frame.size());
+            for (const UC &old : frame)
+                if (!imply(old, r.uc, false))
+                    kept.push_back(old);
+            if (kept.size() < frame.size())
+            {
+                frame.swap(kept);
+                if (r.dst < uc_len_indexes.size())
+                {
+                    uc_len_indexes[r.dst].clear();
+                    for (int i = 0; i < frame.size(); ++i)
+                        insert_to_uc_index(frame[i], i, r.dst);
+                }
+            }
+            addUCtoSolver(r.uc, o, r.dst, Otmp);
+            CARStats.count_async_publish(r.len_before, r.uc.size());
+        }
+    }
+
+    void Checker::warmRestart()
+    {
+        CARStats.count_warm_restart();
+        // as the checkers built by check_aiger() for a cold restart.
+        ++convParam;
+        stuck_detector = StuckDetector(convParam);
+        imply_decision = -1;
+        CARStats.reset_imply_cnter();
+        sat_timer = steady_clock::now();
+    }
+
+    long Checker::reduceTarget(Osequence *O)
+    {
+        // the invariant check needs the initial state out of the frames, only the backward search keeps it as a state.
+        if (!backward_first || (strategy_.frame_budget <= 0 && strategy_.mem_budget <= 0))
+            return 0;
+        long total = 0;
+        for (const Frame &frame : *O)
+            total += frame.size();
+        // well below the budget, so that the frames have to grow back before the next reduction.
+        if (strategy_.frame_budget > 0 && total > strategy_.frame_budget)
+            return strategy_.frame_budget / 2;
+        if (strategy_.mem_budget > 0 && total > mem_rearm && resident_memory_mb() > strategy_.mem_budget)
+            return total / 2;
+        return 0;
+    }
+
+    Frame Checker::mostActive(const Frame &frame, size_t keep)
+    {
+        Frame res = frame;
+        std::stable_sort(res.begin(), res.end(), moreActive);
+        for (size_t i = keep; i < res.size(); ++i)
+            if (imply(Ub[0]->s(), res[i], false))
+                res[keep++] = res[i];
+        if (keep < res.size())
+            res.resize(keep);
+        return res;
+    }
+
+    bool Checker::revalidate(Osequence *O, int level, Frame &frame, long &invalid)
+    {
+        Frame valid;
+        bool init_blocked = false;
+        for (const UC &uc : frame)
+        {
+            bi_main_solver->set_assumption(O, uc, level - 1, false);
+            if (bi_main_solver->solve_with_assumption())
+            {
+                ++invalid;
+                continue;
+            }
+            init_blocked = init_blocked || imply(Ub[0]->s(), uc, false);
+            valid.push_back(uc);
+        }
+        frame.swap(valid);
+        if (init_blocked)
+            return true;
+        bi_main_solver->set_assumption(O, Ub[0], level - 1, false);
+        if (bi_main_solver->solve_with_assumption())
+            return false;
+        frame.push_back(bi_main_solver->get_conflict(false));
+        return true;
+    }
+
+    void Checker::reduceFrames(Osequence *O, long target)
+    {
+        CARStats.count_reduce_begin();
+        long cold = 0, invalid = 0;
+        long total = 0;
+        for (const Frame &frame : *O)
+            total += frame.size();
+        long memory = resident_memory_mb();
+        // the pending UCs were checked against the frames before.
+        if (uc_str)
+            uc_str->forget(O);
+        int lowest = O->size();
+        int levels = O->size();
+        bool below_changed = false;
+        for (int k = 0; k < O->size(); ++k)
+        {
+            Frame &frame = (*O)[k];
+            // each frame keeps its share of the target.
+            Frame kept = mostActive(frame, (frame.size() * target + total - 1) / total);
+            cold += frame.size() - kept.size();
+            if (below_changed && !revalidate(O, k, kept, invalid))
+            {
+                // the frames from here up cannot keep the initial state out, they are built again by the next rounds.
+                levels = k;
+                lowest = std::min(lowest, k);
+                break;
+            }
+            for (const UC &uc : kept)
+                uc.decay();
+            below_changed = kept.size() != frame.size() || !std::equal(kept.begin(), kept.end(), frame.begin(), [](const UC &a, const UC &b)
+                                                                          { return &a.cube() == &b.cube(); });
+            if (!below_changed)
+                continue;
+            lowest = std::min(lowest, k);
+            frame.swap(kept);
+
+            bi_main_solver->retire_frame(O, k);
+            bi_main_solver->add_new_frame(frame, k, O, false);
+            ImplySolver::reset_level(k);
+            if (k < uc_len_indexes.size())
+                uc_len_indexes[k].clear();
+            // the pushes recorded were against the old frame.
+            conv_record.erase(k);
+            for (int i = 0; i < frame.size(); ++i)
+            {
+                if (impMethod != Imp_MOM)
+                    ImplySolver::add_uc(frame[i], k);
+                else
+                    ImplySolver::add_uc_MOM(frame[i], k);
+                insert_to_uc_index(frame[i], i, k);
+            }
+        }
+        for (int k = levels; k < O->size(); ++k)
+        {
+            bi_main_solver->retire_frame(O, k);
+            ImplySolver::reset_level(k);
+            if (k < uc_len_indexes.size())
+                uc_len_indexes[k].clear();
+            conv_record.erase(k);
+        }
+        long dropped = O->size() - levels;
+        O->resize(levels);
+        // the records of the rounds follow the levels, those of the dropped levels go with them.
+        auto drop_last = [dropped](auto &records)
+        { records.resize(records.size() - std::min<size_t>(records.size(), dropped)); };
+        drop_last(spliter);
+        drop_last(blocked_counter_array);
+        drop_last(rotates);
+        drop_last(score_dicts);
+        if (lowest < fresh_levels[O])
+            fresh_levels[O] = lowest;
+        propagated_changes.erase(O);
+        // memory triggers again once the frames have grown back, or have doubled if dropping the UCs did not give any memory back.
+        mem_rearm = resident_memory_mb() < memory ? total : 2 * total;
+        CARStats.count_reduce_end(cold, invalid, dropped);
+    }
+
+    void Checker::propagate(Osequence *O)
+    {
+        CARStats.count_propagate_begin();
+        bool forward = !backward_first;
+        long tried = 0, pushed = 0;
+        // not used: the target level is always below the top.
+        Frame Otmp;
+        std::vector<long> &seen = propagated_changes[O];
+        std::vector<long> &changes = frame_changes[O];
+        if (changes.size() < O->size())
+            changes.resize(O->size(), 0);
+        for (int k = 0; k + 1 < O->size(); ++k)
+        {
+            // the queries of an unchanged frame fail again.
+            if (k < seen.size() && seen[k] == changes[k])
+                continue;
+            // the UCs are interned, the same UC is the same cube.
+            std::unordered_set<const Cube *> next;
+            for (const UC &uc : (*O)[k + 1])
+                next.insert(&uc.cube());
+            // O[k] itself is not changed here.
+            const Frame &frame = (*O)[k];
+            for (int i = 0; i < frame.size(); ++i)
+            {
+                if (next.count(&frame[i].cube()))
+                    continue;
+                ++tried;
+                bi_main_solver->set_assumption(O, frame[i], k, forward);
+                if (bi_main_solver->solve_with_assumption())
+                    continue;
+                // the UC itself, not the core: a shorter core would leave the UC to be tried again in each round.
+                Cube uc = frame[i];
+                addUCtoSolver(uc, O, k + 1, Otmp);
+                next.insert(&frame[i].cube());
+                ++pushed;
+            }
+        }
+        seen.assign(changes.begin(), changes.begin() + O->size());
+        CARStats.count_propagate_end(tried, pushed);
+    }
+
+    void Checker::batchQuery(Usequence &U, Osequence *O, Frame &Otmp)
+    {
+        if (batch_skip > 0)
+        {
+            --batch_skip;
+            return;
+        }
+        // the states pickState() gives next, except U[0]. Those blocked in Otmp are not tried anyway.
+        vector<State *> states;
+        vector<int> indexes;
+        for (int i = pickStateLastIndex - 1; i > 0 && states.size() < strategy_.batch_states; --i)
+        {
+            State *s = U[i];
+            if (s->size() != model_->num_latches() || blockedIn(s, O->size(), O, Otmp))
+                continue;
+            states.push_back(s);
+            indexes.push_back(i);
+        }
+        if (states.size() < 2)
+            return;
+
+        bool forward = !backward_first;
+        State *next = nullptr;
+        Cube uc;
+        CARStats.count_main_solver_original_time_start();
+        int hit = bi_main_solver->solve_batch(O, states, O->size() - 1, forward, next, uc);
+        CARStats.count_main_solver_original_time_end(hit >= 0, uc.size());
+        CARStats.count_batch_states(hit >= 0, !uc.empty());
+        if (hit >= 0)
+        {
+            clear_defer(next);
+            updateU(U, next, states[hit]);
+            std::swap(U[indexes[hit]], U[pickStateLastIndex - 1]);
+            batch_hit = {states[hit], next};
+        }
+        else if (!uc.empty())
+            addUCtoSolver(uc, O, O->size(), Otmp);
+        else
+            batch_skip = states.size();
+    }
+
+    State *Checker::reusedSuccessor(State *s, int level, Osequence *O, Frame &Otmp)
+    {
+        auto it = successors.find(s);
+        if (it == successors.end())
+            return nullptr;
+        // the transition to it still holds, only the frame may have grown since.
+        bool hit = !blockedIn(it->second, level, O, Otmp);
+        CARStats.count_reuse(hit);
+        if (!hit)
+            return nullptr;
+        // it stands for a SAT query.
+        if (convMode == ConvModeStuck)
+            stuck_detector.query(level + 1, false, s->id);
+        return it->second;
+    }
+
     State *Checker::getModel(MainSolver *solver)
     {
         bool forward = !backward_first;
@@ -1290,14 +1606,14 @@ namespace car
         }
         else
         {
-#ifdef PARTIAL
-            Assignment full = solver->get_state_full_assignment(forward);
-            return get_partial_state(full, prior);
-#else
+            if (strategy_.partial)
+            {
+                Assignment full = solver->get_state_full_assignment(forward);
+                return get_partial_state(full, prior);
+            }
             State *s = solver->get_state(forward);
             clear_defer(s);
             return s;
-#endif
         }
     }
 
@@ -1335,14 +1651,19 @@ namespace car
     {
         assert(s);
         assert(Os);
+        if (uc_str)
+            uc_str->forget(Os);
+        // another sequence may get the same address.
+        frame_changes.erase(Os);
+        propagated_changes.erase(Os);
         Os->clear();
         delete (Os);
         SO_map.erase(s);
     }
 
-    void Checker::insert_to_uc_index(Cube&uc, int index, int level)
+    void Checker::insert_to_uc_index(const Cube &uc, int index, int level)
     {
-        if (impMethod != Imp_Sort)
+        if (impMethod != Imp_Sort && impMethod != Imp_Bandit)
             return;
         // about length based manual:
         // level+2: [0,level]
@@ -1361,29 +1682,37 @@ namespace car
 
         Frame &frame = (dst_level_plus_one < int(O->size())) ? (*O)[dst_level_plus_one] : Otmp;
 
-#ifdef FRESH_UC
-        // To add \@ cu to \@ frame, there must be
-        // 1. \@ cu does not imply any clause in \@ frame
-        // 2. if a clause in \@ frame implies \@ cu, replace it by \@cu
-        Frame tmp_frame;
-        for (int i = 0; i < frame.size(); i++)
+        if (strategy_.fresh_uc)
         {
-            if (!imply(frame[i], uc, true))
+            // To add \@ cu to \@ frame, there must be
+            // 1. \@ cu does not imply any clause in \@ frame
+            // 2. if a clause in \@ frame implies \@ cu, replace it by \@cu
+            Frame tmp_frame;
+            for (int i = 0; i < frame.size(); i++)
             {
-                tmp_frame.push_back(frame[i]);
+                if (!imply(frame[i], uc, true))
+                {
+                    tmp_frame.push_back(frame[i]);
+                }
             }
-        }
-        tmp_frame.push_back(uc);
-
-        frame = tmp_frame;
-#else
-        frame.push_back(uc);
-#endif // FRESH_UC
+            tmp_frame.push_back(uc);
 
+            frame = tmp_frame;
+        }
+        else
+            frame.push_back(uc);
+        std::vector<long> &changes = frame_changes[O];
+        if (changes.size() <= dst_level_plus_one)
+            changes.resize(dst_level_plus_one + 1, 0);
+        ++changes[dst_level_plus_one];
+
+        // a UC that is learnt again, or pushed, gains activity too.
+        frame.back().bump();
+        // the handle in the frame, no need to look up the UC store again.
         if(impMethod != Imp_MOM)
-            ImplySolver::add_uc(uc,dst_level_plus_one);
+            ImplySolver::add_uc(frame.back(),dst_level_plus_one);
         else
-            ImplySolver::add_uc_MOM(uc,dst_level_plus_one);
+            ImplySolver::add_uc_MOM(frame.back(),dst_level_plus_one);
 
         insert_to_uc_index(uc,frame.size()-1,dst_level_plus_one);
 
@@ -1649,6 +1978,46 @@ namespace car
                 break;
             }
 
+            case(remem_active):
+            {
+                // NOTE: only implement backward now.
+                assert(backward_first);
+                // Ub[0] = I;
+                updateU(Ub, init, nullptr);
+                pickStateLastIndex = Ub.size();
+
+                // each O[k+1] must still cover the predecessors of O[k] and keep the initial state out, for the invariant check.
+                // The frame below has fewer UCs now, so a kept UC is checked again against it, see revalidate().
+                Onp.clear();
+                SO_map[negp] = &Onp;
+                for (int findex = 0; findex < last_chker->Onp.size(); ++findex)
+                {
+                    const Frame &last = last_chker->Onp[findex];
+                    Frame frame = mostActive(last, last.size() * strategy_.retain_percent / 100);
+                    long invalid = 0;
+                    // the initial state has a successor in the pruned frame below, the frames from here up are learnt again.
+                    if (findex > 0 && !revalidate(&Onp, findex, frame, invalid))
+                        break;
+                    Onp.push_back(frame);
+
+                    for (int index = 0; index < frame.size(); ++index)
+                    {
+                        if (impMethod != Imp_MOM)
+                            ImplySolver::add_uc(frame[index], findex);
+                        else
+                            ImplySolver::add_uc_MOM(frame[index], findex);
+                        insert_to_uc_index(frame[index], index, findex);
+                    }
+                    bi_main_solver->add_new_frame(frame, findex, &Onp, false);
+                }
+
+                if (get_rotate())
+                {
+                    rotates.push_back(init->s());
+                }
+                return false;
+            }
+
         default:
             break;
         }
@@ -1675,24 +2044,21 @@ namespace car
     // NOTE: if not updated, it return the same state all the time?
     State *Checker::enumerateStartStates(StartSolver *start_solver)
     {
-// partial state:
-#ifdef PARTIAL
-        if (start_solver->solve_with_assumption())
-        {
-            Assignment ass = start_solver->get_model();
-            ass.resize(model_->num_inputs() + model_->num_latches());
-            State *partial_res = get_partial_state(ass, nullptr);
-            clear_defer(partial_res);
-            return partial_res;
-        }
-#else
         if (start_solver->solve_with_assumption())
         {
+            // partial state:
+            if (strategy_.partial)
+            {
+                Assignment ass = start_solver->get_model();
+                ass.resize(model_->num_inputs() + model_->num_latches());
+                State *partial_res = get_partial_state(ass, nullptr);
+                clear_defer(partial_res);
+                return partial_res;
+            }
             State *res = start_solver->create_new_state();
             clear_defer(res);
             return res;
         }
-#endif
         return NULL;
     }
 
@@ -1805,6 +2171,7 @@ namespace car
      * @brief
      * @pre s->s() is in abs-increasing order
      *
+     * @param method one of ImpHowEnum
      * @param s
      * @param frame_level
      * @param O
@@ -1812,10 +2179,10 @@ namespace car
      * @return true
      * @return false
      */
-    bool Checker::blockedIn(State *s, const int frame_level, Osequence *O, Frame &Otmp)
+    bool Checker::blockedWith(int method, State *s, const int frame_level, Osequence *O, Frame &Otmp)
     {
         bool res = false;
-        switch (impMethod)
+        switch (method)
         {
             case(Imp_Manual):
             {
@@ -1827,6 +2194,7 @@ namespace car
                     CARStats.count_1_end(res);
                     if (res)
                     {
+                        uc.bump();
                         break;
                     }
                 }
@@ -1860,15 +2228,7 @@ namespace car
                 {
                     if(imply_decision == -1)
                         CARStats.count_imply_dec_begin();
-                    Frame &frame = (frame_level < O->size()) ? (*O)[frame_level] : Otmp;
-                    for (const auto &uc : frame)
-                    {
-                        res = s->imply(uc);
-                        if (res)
-                        {
-                            break;
-                        }
-                    }
+                    res = blockedByScan(s, frame_level, O, Otmp);
                     if(imply_decision == -1)
                         CARStats.count_imply_dec_end(2);
                 }
@@ -1895,6 +2255,7 @@ namespace car
                     res = s->imply(uc);
                     if (res)
                     {
+                        uc.bump();
                         break;
                     }
                 }
@@ -1947,6 +2308,7 @@ namespace car
                         res = s->imply(uc);
                         if (res)
                         {
+                            uc.bump();
                             break;
                         }
                     }
@@ -1960,12 +2322,41 @@ namespace car
                 break;
             }
 
+            case (Imp_Bandit):
+            {
+                int arm = imply_bandit.pick(frame_level);
+                int arm_method = imply_bandit.arms()[arm];
+                uint64_t begin = cycle_count();
+                // the statistics of Imp_Manual, timed per UC, would be charged to its arm.
+                if (arm_method == Imp_Manual)
+                    res = blockedByScan(s, frame_level, O, Otmp);
+                else
+                    res = blockedWith(arm_method, s, frame_level, O, Otmp);
+                imply_bandit.reward(frame_level, arm, cycle_count() - begin);
+                CARStats.record_bandit_pick(imply_bandit.arms()[arm]);
+                break;
+            }
+
             default:
                 break;
         }
         return res;
     }
 
+    bool Checker::blockedByScan(State *s, const int frame_level, Osequence *O, Frame &Otmp)
+    {
+        Frame &frame = (frame_level < O->size()) ? (*O)[frame_level] : Otmp;
+        for (const auto &uc : frame)
+        {
+            if (s->imply(uc))
+            {
+                uc.bump();
+                return true;
+            }
+        }
+        return false;
+    }
+
     /**
      * @brief Find minimal level among [min,max] that s is not blocked in. 
      * 
@@ -7,15 +7,24 @@
 #include "startsolver.h"
 #include "mainsolver.h"
 #include "newpartialsolver.h"
+#include "ucdiversifier.h"
+#include "ucstrengthener.h"
 #include "model.h"
 #include <assert.h>
 #include "utility.h"
 #include "statistics.h"
+#include "strategy.h"
+#include "bandit.h"
+#include "stuck.h"
+#include "restart.h"
 #include <unordered_map>
 #include <unordered_set>
 #include <set>
 #include <fstream>
 #include <map>
+#include <queue>
+#include <stack>
+#include <type_traits>
 
 namespace car
 {
@@ -26,6 +35,17 @@ namespace car
     class Checker;
     extern Checker ch;
 
+    /**
+     * @brief The part of the strategy that is specialized at compile time, because it is in the hot loops of trySAT() and satAssume().
+     * One of them is picked when the checker is created. See Checker::select_policy().
+     */
+    template <bool PQueue, bool Score>
+    struct SearchPolicy
+    {
+        using Container = typename std::conditional<PQueue, std::priority_queue<item, std::vector<item>, CompareItem>, std::stack<item>>::type;
+        static constexpr bool score = Score;
+    };
+
     class Checker
     {
     public:
@@ -43,11 +63,11 @@ namespace car
          * @param index_to_check the index of property to check. At present, only one property is allowed
 
          */
-        Checker(Model *model, std::ostream &out, std::ofstream &trail_out, std::ofstream &dot_out, std::ofstream &dive_out, bool enable_dive, bool forward = true, bool evidence = false, int index_to_check = 0, int convMode = -1, int convParam = 0, bool enable_rotate = false, int inter_cnt=0, bool inv_incomplete = false, bool uc_raw = false, int impMethod = 0);
+        Checker(Model *model, std::ostream &out, std::ofstream &trail_out, std::ofstream &dot_out, std::ofstream &dive_out, bool enable_dive, bool forward = true, bool evidence = false, int index_to_check = 0, int convMode = -1, int convParam = 0, bool enable_rotate = false, int inter_cnt=0, bool inv_incomplete = false, bool uc_raw = false, int impMethod = 0, const Strategy &strategy = Strategy());
 
-        Checker(int time_limit, Model *model, std::ostream &out, std::ofstream &trail_out, std::ofstream &dot_out, std::ofstream &dive_out, bool enable_dive, bool forward = true, bool evidence = false, int index_to_check = 0, int convMode = -1, int convParam = 0, bool enable_rotate = false, int inter_cnt=0, bool inv_incomplete = false, bool uc_raw = false, int impMethod = 0);
+        Checker(int time_limit, Model *model, std::ostream &out, std::ofstream &trail_out, std::ofstream &dot_out, std::ofstream &dive_out, bool enable_dive, bool forward = true, bool evidence = false, int index_to_check = 0, int convMode = -1, int convParam = 0, bool enable_rotate = false, int inter_cnt=0, bool inv_incomplete = false, bool uc_raw = false, int impMethod = 0, const Strategy &strategy = Strategy());
 
-        Checker(int time_limit, Checker* last_chker, int rememOption, Model *model, std::ostream &out, std::ofstream &trail_out, std::ofstream &dot_out, std::ofstream &dive_out, bool enable_dive, bool forward = true, bool evidence = false, int index_to_check = 0, int convMode = -1, int convParam = 0, bool enable_rotate = false, int inter_cnt=0, bool inv_incomplete = false, bool uc_raw = false, int impMethod = 0);
+        Checker(int time_limit, Checker* last_chker, int rememOption, Model *model, std::ostream &out, std::ofstream &trail_out, std::ofstream &dot_out, std::ofstream &dive_out, bool enable_dive, bool forward = true, bool evidence = false, int index_to_check = 0, int convMode = -1, int convParam = 0, bool enable_rotate = false, int inter_cnt=0, bool inv_incomplete = false, bool uc_raw = false, int impMethod = 0, const Strategy &strategy = Strategy());
 
         /**
          * @brief Destroy the Checker object
@@ -59,6 +79,9 @@ namespace car
         bool check();
 
     private:
+        // the setup shared by the constructors, once the members are initialized.
+        void init(bool forward, int index_to_check);
+
         // entrance for CAR
         bool car();
 
@@ -81,8 +104,13 @@ namespace car
          * @return true : successfully reached O[0]. which means a cex is found.
          * @return false : all states in present U has been checked. No cex is found.
          */
+        template <class Policy>
         bool trySAT(Usequence &U, Osequence *O, bool forward, bool &safe_reported);
 
+        // trySAT() of the policy picked by select_policy().
+        bool (Checker::*try_sat_)(Usequence &U, Osequence *O, bool forward, bool &safe_reported);
+        void select_policy();
+
     public:
         /**
          * @section Preprocessing technique
@@ -99,10 +127,20 @@ namespace car
             remem_short = 2,
             remem_Ok = 3,
             remem_Uk = 4,
+            // every frame of Onp, each cut to its most active UCs, see Strategy::retain_percent.
+            remem_active = 5,
         };
+        // when to restart, unless Strategy::restart_kind is Restart_Time.
+        RestartPolicy restart_policy;
         Checker* last_chker;
         int rememOption = 0;
 
+        /**
+         * @brief the restart of Strategy::warm_restart: the next convParam, and a fresh decision of the implication method, on the same frames and solvers.
+         * The UCs are kept, since a clause cannot be taken out of the solvers.
+         */
+        void warmRestart();
+
         int inter_cnt = 0;
         bool rotate_enabled = false;
         bool inv_incomplete =false;
@@ -117,10 +155,14 @@ namespace car
             Imp_Exp = 4,
             Imp_Thresh = 5,
             Imp_MOM = 6,
+            Imp_Bandit = 7,
         };
 
         int impMethod = 0;
+        // Imp_Bandit: picks one of the methods at each level, by their cost in cycles.
+        LevelBandit imply_bandit{{Imp_Manual, Imp_Sort, Imp_Solver}};
 
+        Strategy strategy_;
         
         clock_high sat_timer;
 
@@ -150,16 +192,18 @@ namespace car
             ConvModeAlways = 0,
             ConvModeLow = 1,
             ConvModeHigh = 2,
+            // only where the search is stuck, see StuckDetector. convParam is the patience.
             ConvModeStuck = 3,
             ConvModeRand = 4
         };
         int convMode=-1;
         int convParam=0;
+        StuckDetector stuck_detector{0};
 
         // for better manual method
         // maintain the index to visit.
         std::vector<std::set<std::pair<int,int>>> uc_len_indexes;
-        void insert_to_uc_index(Cube &uc,int index, int level);
+        void insert_to_uc_index(const Cube &uc,int index, int level);
 
     public:
         Model *model_;
@@ -172,6 +216,10 @@ namespace car
         std::unordered_map<const State *, Osequence *> SO_map;
         // the main solver shared.
         MainSolver *bi_main_solver;
+        // the clones of the main solver that compute another UC with convMode, see Strategy::div_workers.
+        UCDiversifier *uc_div = nullptr;
+        // the clone of the main solver that shortens the UCs in the background, see Strategy::mic_async.
+        UCStrengthener *uc_str = nullptr;
         // the partial solver shared.
         PartialSolver *bi_partial_solver;
         // count of blocked states.
@@ -179,6 +227,18 @@ namespace car
 
         // the map from O sequence to its minimal_level
         std::unordered_map<const Osequence *, int> fresh_levels;
+        // the number of UCs added to each frame, by addUCtoSolver(). A UC may replace others, so the size may not change.
+        std::unordered_map<const Osequence *, std::vector<long>> frame_changes;
+        // frame_changes at the last propagate(), see Strategy::propagate.
+        std::unordered_map<const Osequence *, std::vector<long>> propagated_changes;
+        // the number of UCs the frames must exceed before Strategy::mem_budget triggers a reduction again.
+        long mem_rearm = 0;
+        // the state that batchQuery() found with a successor, and the successor.
+        std::pair<State *, State *> batch_hit = {nullptr, nullptr};
+        // the picks left before the next batchQuery().
+        int batch_skip = 0;
+        // the last successor found for each state by the main solver, see Strategy::reuse_successor.
+        std::unordered_map<const State *, State *> successors;
         Usequence Uf, Ub; // Uf[0] is not explicitly constructed
         Osequence Onp, OI;
         // used in picking state randomly
@@ -284,6 +344,16 @@ namespace car
         State *getModel(MainSolver *);
         State *getModel(MainSolver *, State *);
 
+        /**
+         * @brief with Strategy::batch_states, one query for the next states that pickState() would give, against the top frame of O.
+         * If one of them has a successor, it is moved to be picked next, and its successor is kept in batch_hit for its first query.
+         * If none has, and the core does not need the selectors, the UC blocks them all in Otmp. Otherwise they are tried one by one, and the next ones are not batched.
+         */
+        void batchQuery(Usequence &U, Osequence *O, Frame &Otmp);
+
+        // the successor found for s the last time, if O[level] does not block it yet, see Strategy::reuse_successor. nullptr otherwise.
+        State *reusedSuccessor(State *s, int level, Osequence *O, Frame &Otmp);
+
         /**
          * @brief Update U sequence, and push into cex vector
          *
@@ -307,6 +377,7 @@ namespace car
          * @return true
          * @return false
          */
+        template <class Policy>
         bool satAssume(MainSolver *, Osequence *O, State *, int, Frame &Otmp, bool &safe_reported);
 
         /**
@@ -332,6 +403,47 @@ namespace car
          */
         void addUCtoSolver(Cube &uc, Osequence *O, int dst_level, Frame &Otmp);
 
+        /**
+         * @brief drop literals from the UC of a failed query of O[level], as long as the query stays UNSAT. The core of each successful try replaces the UC.
+         * See Strategy::mic_attempts and Strategy::mic_budget.
+         * @post the assumption of the solver is the one of the failed query again.
+         */
+        void generalize(MainSolver *solver, Osequence *O, int level, Cube &uc);
+
+        /**
+         * @brief add the UCs shortened in the background to their frames, and retire the UCs of those frames that they imply.
+         * A UC for the top frame of another O sequence than this one is dropped, since its Otmp is not at hand.
+         */
+        void collectStrengthened(Osequence *O, Frame &Otmp);
+
+        // the number of UCs to reduce the frames of O to, if they are over Strategy::frame_budget or Strategy::mem_budget. 0 otherwise.
+        long reduceTarget(Osequence *O);
+
+        // the `keep` most active UCs of the frame, and all those that block the initial state.
+        Frame mostActive(const Frame &frame, size_t keep);
+
+        /**
+         * @brief keep the UCs of O[level] that still hold against O[level-1] in the main solver, count the others in `invalid`.
+         * If none of them blocks the initial state any more, it is blocked again with a new UC.
+         * @return false if it cannot be, that is, the initial state has a successor in O[level-1].
+         */
+        bool revalidate(Osequence *O, int level, Frame &frame, long &invalid);
+
+        /**
+         * @brief drop the cold UCs of each frame of O, so that they hold about `target` UCs in all, like a reduction of learnt clauses. The activities of the kept ones decay.
+         * For the invariant check, each O[k+1] must still cover the predecessors of O[k], and no frame may hold the initial state.
+         * So the UCs that block the initial state are kept, and once a frame has lost UCs, the frame above is checked again against it, see revalidate().
+         * If the initial state cannot be kept out of a frame, the frames from there up are dropped.
+         * A changed frame gets a new flag in the main solver, and its implication engines are built again.
+         */
+        void reduceFrames(Osequence *O, long target);
+
+        /**
+         * @brief push each UC of O[k] to O[k+1], if no state in it has a successor in O[k].
+         * UCs that are already in O[k+1] are skipped. See Strategy::propagate.
+         */
+        void propagate(Osequence *O);
+
         /**
          * @brief init special sequences: Uf, Ub, Oi, Onp
          */
@@ -375,7 +487,10 @@ namespace car
          * @return true
          * @return false
          */
-        bool blockedIn(State *s, const int frame_level, Osequence *O, Frame &Otmp);
+        inline bool blockedIn(State *s, const int frame_level, Osequence *O, Frame &Otmp) { return blockedWith(impMethod, s, frame_level, O, Otmp); }
+        bool blockedWith(int method, State *s, const int frame_level, Osequence *O, Frame &Otmp);
+        // the manual check without statistics, and bump the UC that blocks s.
+        bool blockedByScan(State *s, const int frame_level, Osequence *O, Frame &Otmp);
 
         /**
          * @brief Use `blocked in` to iterate, from min to max, to find the minimal level where this state is not blocked.
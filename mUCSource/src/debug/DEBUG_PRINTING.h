@@ -7,11 +7,7 @@
 // print prior map in `print_evidence()`
 // #define PRINT_PRIOR
 
-#ifdef TRAIL
-#define LOG(msg) trail_out<<msg<<std::endl;
-#else
-#define LOG(msg)
-#endif
+#define LOG(msg) if(strategy_.trail) {trail_out<<msg<<std::endl;}
 
 #ifdef DIVE
 #define DIVE_DRAW(a,b,c,d,e,f) if(enable_dive) {dive_draw_wedge(a,b,c,d,e,f); }
@@ -22,12 +18,6 @@
 
 #define DRAW(from,to) if(dot_out.is_open()) {dot_out<<to << " [style=filled, fillcolor=red];"<<std::endl; dot_out<<from<<" -> "<<to<<std::endl;}
 
-#ifdef PQUEUE
-#define CONTAINER priority_queue<item,std::vector<item>, CompareItem>
-#else
-#define CONTAINER stack<item>
-#endif
-
 #ifdef PRINT_SIMPLE_SAT
 #define PRINTIF_SIMPLE_SAT()                                                            \
 	static int sat_cnt = 0;                                                           \
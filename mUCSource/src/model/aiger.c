@@ -27,7 +27,11 @@ IN THE SOFTWARE.
 #include <stdlib.h>
 #include <assert.h>
 #include <ctype.h>
+#include <limits.h>
 #include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 
 
 /*------------------------------------------------------------------------*/
@@ -2617,6 +2621,245 @@ aiger_open_and_read_from_file (aiger * public, const char *file_name)
   return res;
 }
 
+/*------------------------------------------------------------------------*/
+/* Reader for binary files which are mapped into memory.  The header, the
+ * latch, output, bad and constraint sections are parsed from the mapped
+ * bytes, and the delta encoded AND section is decoded in one tight loop.
+ * All tables are allocated with their final size up front and the type
+ * table is filled directly, so no 'aiger_add_*' bookkeeping is needed.
+ * Symbol table and comments are not read.
+ */
+
+static const unsigned char *
+aiger_mmap_uint (const unsigned char *p, const unsigned char *end,
+		 unsigned *res_ptr)
+{
+  unsigned res;
+
+  if (p == end || !isdigit (*p))
+    return 0;
+
+  res = 0;
+  while (p < end && isdigit (*p))
+    {
+      if (res > (UINT_MAX - 9) / 10)
+	return 0;
+      res = 10 * res + (*p++ - '0');
+    }
+
+  *res_ptr = res;
+  return p;
+}
+
+static const unsigned char *
+aiger_mmap_line (const unsigned char *p, const unsigned char *end,
+		 unsigned *res_ptr)
+{
+  p = aiger_mmap_uint (p, end, res_ptr);
+  if (!p || p == end || *p != '\n')
+    return 0;
+  return p + 1;
+}
+
+static const unsigned char *
+aiger_mmap_delta (const unsigned char *p, const unsigned char *end,
+		  unsigned *res_ptr)
+{
+  unsigned res, shift;
+  unsigned char ch;
+
+  res = 0;
+  shift = 0;
+  do
+    {
+      if (p == end || shift > 28)
+	return 0;
+      ch = *p++;
+      res |= (ch & 0x7f) << shift;
+      shift += 7;
+    }
+  while (ch & 0x80);
+
+  *res_ptr = res;
+  return p;
+}
+
+static const char *
+aiger_mmap_decode (aiger * public,
+		   const unsigned char *p, const unsigned char *end)
+{
+  IMPORT_private_FROM (public);
+  unsigned header[9], num_header, i, lit, next, reset, lhs, rhs0, rhs1;
+  unsigned delta0, delta1, var;
+  aiger_symbol *symbol;
+  aiger_type *type;
+  aiger_and *and;
+
+  if (end - p < 4 || memcmp (p, "aig ", 4))
+    return aiger_error_s (private, "%s", "not a binary AIGER file");
+  p += 4;
+
+  memset (header, 0, sizeof (header));
+  for (num_header = 0; num_header < 9; num_header++)
+    {
+      p = aiger_mmap_uint (p, end, header + num_header);
+      if (!p || p == end)
+	return aiger_error_s (private, "%s", "invalid header");
+      if (*p++ == '\n')
+	break;
+    }
+
+  if (num_header < 4 || num_header == 9)
+    return aiger_error_s (private, "%s", "invalid header");
+
+  if (header[7] || header[8])
+    return aiger_error_s (private, "%s",
+			  "justice and fairness are not supported");
+
+  if (header[1] + header[2] + header[4] != header[0])
+    return aiger_error_s (private, "%s", "invalid maximal variable index");
+
+  public->maxvar = header[0];
+
+  FIT (private->types, private->size_types, public->maxvar + 1);
+  FIT (public->inputs, private->size_inputs, header[1]);
+  FIT (public->latches, private->size_latches, header[2]);
+  FIT (public->outputs, private->size_outputs, header[3]);
+  FIT (public->ands, private->size_ands, header[4]);
+  FIT (public->bad, private->size_bad, header[5]);
+  FIT (public->constraints, private->size_constraints, header[6]);
+
+  for (i = 0; i < header[1]; i++)
+    {
+      lit = 2 * (i + 1);
+      type = private->types + aiger_lit2var (lit);
+      type->input = 1;
+      type->idx = i;
+      public->inputs[i].lit = lit;
+    }
+  public->num_inputs = header[1];
+
+  for (i = 0; i < header[2]; i++)
+    {
+      lit = 2 * (header[1] + i + 1);
+      reset = 0;
+
+      p = aiger_mmap_uint (p, end, &next);
+      if (p && p < end && *p == ' ')
+	p = aiger_mmap_uint (p + 1, end, &reset);
+      if (!p || p == end || *p++ != '\n')
+	return aiger_error_u (private, "invalid latch %u", i);
+
+      if (aiger_lit2var (next) > public->maxvar
+	  || (reset > 1 && reset != lit))
+	return aiger_error_u (private, "invalid latch %u", i);
+
+      type = private->types + aiger_lit2var (lit);
+      type->latch = 1;
+      type->idx = i;
+
+      symbol = public->latches + i;
+      symbol->lit = lit;
+      symbol->next = next;
+      symbol->reset = reset;
+    }
+  public->num_latches = header[2];
+
+  for (i = 0; i < header[3]; i++)
+    {
+      p = aiger_mmap_line (p, end, &lit);
+      if (!p || aiger_lit2var (lit) > public->maxvar)
+	return aiger_error_u (private, "invalid output %u", i);
+      public->outputs[i].lit = lit;
+    }
+  public->num_outputs = header[3];
+
+  for (i = 0; i < header[5]; i++)
+    {
+      p = aiger_mmap_line (p, end, &lit);
+      if (!p || aiger_lit2var (lit) > public->maxvar)
+	return aiger_error_u (private, "invalid bad %u", i);
+      public->bad[i].lit = lit;
+    }
+  public->num_bad = header[5];
+
+  for (i = 0; i < header[6]; i++)
+    {
+      p = aiger_mmap_line (p, end, &lit);
+      if (!p || aiger_lit2var (lit) > public->maxvar)
+	return aiger_error_u (private, "invalid constraint %u", i);
+      public->constraints[i].lit = lit;
+    }
+  public->num_constraints = header[6];
+
+  lhs = 2 * (header[1] + header[2]);
+  var = header[1] + header[2];
+  and = public->ands;
+  for (i = 0; i < header[4]; i++)
+    {
+      lhs += 2;
+      var++;
+
+      p = aiger_mmap_delta (p, end, &delta0);
+      if (!p || !delta0 || delta0 > lhs)
+	return aiger_error_u (private, "invalid AND %u", i);
+      rhs0 = lhs - delta0;
+
+      p = aiger_mmap_delta (p, end, &delta1);
+      if (!p || delta1 > rhs0)
+	return aiger_error_u (private, "invalid AND %u", i);
+      rhs1 = rhs0 - delta1;
+
+      type = private->types + var;
+      type->and = 1;
+      type->idx = i;
+
+      and->lhs = lhs;
+      and->rhs0 = rhs0;
+      and->rhs1 = rhs1;
+      and++;
+    }
+  public->num_ands = header[4];
+
+  return 0;
+}
+
+const char *
+aiger_mmap_read_binary (aiger * public, const char *file_name)
+{
+  IMPORT_private_FROM (public);
+  const unsigned char *start;
+  const char *res;
+  struct stat st;
+  size_t bytes;
+  int fd;
+
+  assert (!aiger_error (public));
+  assert (!public->maxvar);
+
+  fd = open (file_name, O_RDONLY);
+  if (fd < 0)
+    return aiger_error_s (private, "can not read '%s'", file_name);
+
+  if (fstat (fd, &st) || st.st_size <= 0)
+    {
+      close (fd);
+      return aiger_error_s (private, "can not map '%s'", file_name);
+    }
+
+  bytes = st.st_size;
+  start = mmap (0, bytes, PROT_READ, MAP_PRIVATE, fd, 0);
+  close (fd);
+  if (start == MAP_FAILED)
+    return aiger_error_s (private, "can not map '%s'", file_name);
+
+  madvise ((void *) start, bytes, MADV_SEQUENTIAL);
+  res = aiger_mmap_decode (public, start, start + bytes);
+  munmap ((void *) start, bytes);
+
+  return res;
+}
+
 const char *
 aiger_get_symbol (aiger * public, unsigned lit)
 {
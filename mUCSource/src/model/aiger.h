@@ -306,6 +306,14 @@ const char *aiger_error (aiger *);
  */
 const char *aiger_open_and_read_from_file (aiger *, const char *);
 
+/*------------------------------------------------------------------------*/
+/* Faster reader for uncompressed binary files, which maps the file into
+ * memory.  Same semantics as 'aiger_open_and_read_from_file', but symbols
+ * and comments are skipped, and justice or fairness properties are
+ * reported as an error.  The result is reencoded already.
+ */
+const char *aiger_mmap_read_binary (aiger *, const char *);
+
 /*------------------------------------------------------------------------*/
 /* Write symbol table or the comments to a file.  Result is zero on failure.
  */
@@ -0,0 +1,188 @@
+#include "coi.h"
+#include <assert.h>
+#include <string>
+
+using namespace std;
+
+namespace car{
+
+	COI::COI (aiger* aig, const int index_to_check) : origin_(aig), reduced_(NULL)
+	{
+		assert (aiger_is_reencoded (aig));
+		assert (index_to_check < aig->num_outputs);
+
+		vector<char> in_coi (aig->maxvar + 1, 0);
+		collect (index_to_check, in_coi);
+		build (index_to_check, in_coi);
+	}
+
+	COI::~COI ()
+	{
+		if (reduced_)
+		{
+			aiger_reset (reduced_);
+			reduced_ = NULL;
+		}
+	}
+
+	/**
+	 * @brief mark every variable that the checked output (or a constraint) depends on, through and gates and the next-state function of latches.
+	 * @note with a reencoded aiger: inputs are [1, I], latches are [I+1, I+L], and gates follow.
+	 *
+	 * @param index_to_check
+	 * @param in_coi
+	 */
+	void COI::collect (const int index_to_check, vector<char>& in_coi)
+	{
+		const unsigned num_inputs = origin_->num_inputs;
+		const unsigned num_latches = origin_->num_latches;
+		vector<unsigned> todo;
+
+		todo.push_back (aiger_lit2var (origin_->outputs[index_to_check].lit));
+		for (int i = 0; i < origin_->num_constraints; i ++)
+			todo.push_back (aiger_lit2var (origin_->constraints[i].lit));
+
+		while (!todo.empty ())
+		{
+			unsigned var = todo.back ();
+			todo.pop_back ();
+			// 0 is the constant
+			if (var == 0 || in_coi[var])
+				continue;
+			in_coi[var] = 1;
+
+			if (var <= num_inputs)
+				continue;
+			else if (var <= num_inputs + num_latches)
+			{
+				const aiger_symbol& latch = origin_->latches[var - num_inputs - 1];
+				todo.push_back (aiger_lit2var (latch.next));
+			}
+			else
+			{
+				const aiger_and& aa = origin_->ands[var - num_inputs - num_latches - 1];
+				assert (aiger_lit2var (aa.lhs) == var);
+				todo.push_back (aiger_lit2var (aa.rhs0));
+				todo.push_back (aiger_lit2var (aa.rhs1));
+			}
+		}
+	}
+
+	/**
+	 * @brief create the reduced aiger with the marked variables.
+	 * Literals are kept as they are in the original model, and then reencoded, which keeps the order of inputs and latches.
+	 *
+	 * @param index_to_check
+	 * @param in_coi
+	 */
+	void COI::build (const int index_to_check, const vector<char>& in_coi)
+	{
+		reduced_ = aiger_init ();
+
+		input_pos_.assign (origin_->num_inputs, -1);
+		for (int i = 0; i < origin_->num_inputs; i ++)
+		{
+			unsigned lit = origin_->inputs[i].lit;
+			if (!in_coi[aiger_lit2var (lit)])
+				continue;
+			input_pos_[i] = kept_inputs_.size ();
+			kept_inputs_.push_back (i);
+			aiger_add_input (reduced_, lit, NULL);
+		}
+
+		latch_pos_.assign (origin_->num_latches, -1);
+		for (int i = 0; i < origin_->num_latches; i ++)
+		{
+			const aiger_symbol& latch = origin_->latches[i];
+			if (!in_coi[aiger_lit2var (latch.lit)])
+				continue;
+			latch_pos_[i] = kept_latches_.size ();
+			kept_latches_.push_back (i);
+			aiger_add_latch (reduced_, latch.lit, latch.next, NULL);
+			aiger_add_reset (reduced_, latch.lit, latch.reset);
+		}
+
+		for (int i = 0; i < origin_->num_ands; i ++)
+		{
+			const aiger_and& aa = origin_->ands[i];
+			if (in_coi[aiger_lit2var (aa.lhs)])
+				aiger_add_and (reduced_, aa.lhs, aa.rhs0, aa.rhs1);
+		}
+
+		aiger_add_output (reduced_, origin_->outputs[index_to_check].lit, NULL);
+		for (int i = 0; i < origin_->num_constraints; i ++)
+			aiger_add_constraint (reduced_, origin_->constraints[i].lit, NULL);
+
+		aiger_reencode (reduced_);
+
+		assert (reduced_->num_inputs == kept_inputs_.size ());
+		assert (reduced_->num_latches == kept_latches_.size ());
+	}
+
+	/**
+	 * @brief The witness is :
+	 * 	1
+	 *  b0
+	 *  <latches>
+	 *  <inputs>*
+	 *  .
+	 * Only <latches> and <inputs> need to be widened. Other results are copied as they are.
+	 *
+	 * @param in
+	 * @param out
+	 */
+	void COI::lift_witness (istream& in, ostream& out) const
+	{
+		string line;
+		int line_no = 0;
+		bool unsafe = false;
+		while (getline (in, line))
+		{
+			if (line_no == 0)
+				unsafe = (line == "1");
+
+			if (!unsafe || line_no < 2 || line == ".")
+			{
+				out << line << endl;
+				++line_no;
+				continue;
+			}
+
+			string lifted;
+			if (line_no == 2)
+			{
+				// the initial state
+				lifted.resize (origin_->num_latches);
+				for (int i = 0; i < origin_->num_latches; i ++)
+				{
+					int pos = latch_pos_[i];
+					if (pos >= 0 && pos < line.size ())
+						lifted[i] = line[pos];
+					else
+						lifted[i] = (origin_->latches[i].reset == 1) ? '1' : '0';
+				}
+			}
+			else
+			{
+				// inputs of one step
+				lifted.resize (origin_->num_inputs);
+				for (int i = 0; i < origin_->num_inputs; i ++)
+				{
+					int pos = input_pos_[i];
+					lifted[i] = (pos >= 0 && pos < line.size ()) ? line[pos] : '0';
+				}
+			}
+			out << lifted << endl;
+			++line_no;
+		}
+	}
+
+	void COI::print () const
+	{
+		cout << "-------------------COI information--------------------" << endl;
+		cout << "inputs: " << kept_inputs_.size () << " / " << origin_->num_inputs << endl;
+		cout << "latches: " << kept_latches_.size () << " / " << origin_->num_latches << endl;
+		cout << "ands: " << reduced_->num_ands << " / " << origin_->num_ands << endl;
+		cout << "-------------------End of COI information--------------------" << endl;
+	}
+}
@@ -0,0 +1,67 @@
+#ifndef COI_H
+#define COI_H
+
+extern "C" {
+#include "aiger.h"
+}
+#include <iostream>
+#include <vector>
+
+namespace car {
+
+	/**
+	 * @brief Sequential cone of influence reduction.
+	 *
+	 * Starting from the checked output (and the constraints), we collect every gate, input and latch
+	 * that can transitively affect it, going through the next-state functions of the latches.
+	 * The reduced aiger only contains those, so that States, assumptions and the transition relation
+	 * in every solver shrink to the relevant part of the design.
+	 *
+	 * Witnesses found on the reduced model are lifted back to the original width by `lift_witness()`:
+	 * latches outside the cone keep their initial value, inputs outside the cone are set to 0.
+	 *
+	 * @pre the original aiger is reencoded.
+	 */
+	class COI {
+	public:
+		COI (aiger* aig, const int index_to_check = 0);
+		~COI ();
+
+		// the reduced aiger, owned by this object. It is reencoded already.
+		inline aiger* reduced () const { return reduced_; }
+
+		inline int num_kept_inputs () const { return kept_inputs_.size (); }
+		inline int num_kept_latches () const { return kept_latches_.size (); }
+		inline int num_kept_ands () const { return reduced_->num_ands; }
+
+		// whether all latches are kept, which means the reduction brings nothing.
+		inline bool trivial () const { return kept_latches_.size () == origin_->num_latches; }
+
+		/**
+		 * @brief rewrite a witness (in aiger format) of the reduced model into one for the original model.
+		 *
+		 * @param in witness printed by the checker
+		 * @param out where to print the lifted witness
+		 */
+		void lift_witness (std::istream& in, std::ostream& out) const;
+
+		void print () const;
+
+	private:
+		aiger* origin_;
+		aiger* reduced_;
+
+		// index in the original model for each input / latch of the reduced model.
+		std::vector<int> kept_inputs_;
+		std::vector<int> kept_latches_;
+		// for each latch of the original model, its index in the reduced one, -1 if it is dropped.
+		std::vector<int> latch_pos_;
+		std::vector<int> input_pos_;
+
+		void collect (const int index_to_check, std::vector<char>& in_coi);
+		void build (const int index_to_check, const std::vector<char>& in_coi);
+	};
+
+}
+
+#endif
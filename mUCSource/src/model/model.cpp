@@ -1,16 +1,25 @@
 #include "model.h"
 #include "utility.h"
+#include "preprocessor.h"
 #include <stdlib.h>
+#include <algorithm>
 #include <iostream>
 #include <assert.h>
+#include <fstream>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 
 using namespace std;
 
 namespace car{
 
-	Model::Model (aiger* aig, const bool verbose)
+	Model::Model (aiger* aig, const bool verbose, const bool polarity_aware, const bool simplify)
 	{
 		verbose_ = verbose;
+		polarity_aware_ = polarity_aware;
 		// According to aiger format, inputs should be [1 ... num_inputs_]
 		// and latches should be [num_inputs+1 ... num_latches+num_inputs]]
 		num_inputs_ = aig->num_inputs;
@@ -25,6 +34,7 @@ namespace car{
 		true_ = max_id_ - 1;
 		false_ = max_id_;
 		
+		trues_.assign (2 * (aig->maxvar + 1), 0);
 		collect_trues (aig);
 		
 		set_constraints (aig);
@@ -32,7 +42,11 @@ namespace car{
 		set_init (aig);
 		
 		create_next_map (aig);
+		if (polarity_aware_)
+			compute_polarity (aig);
 		create_clauses (aig);
+		if (simplify)
+			this->simplify ();
 	}
 	
 	// collect those that is trivially constant
@@ -44,13 +58,13 @@ namespace car{
 			// lhs of an and gate is always even in aiger
 			assert (aa.lhs % 2 == 0);
 			if (is_true (aa.rhs0) && is_true (aa.rhs1))
-				trues_.insert (aa.lhs);
+				trues_[aa.lhs] = 1;
 			else if (is_false (aa.rhs0) || is_false (aa.rhs1))
-				trues_.insert (aa.lhs + 1);
+				trues_[aa.lhs + 1] = 1;
 			// lhs = 8 * 7 = a4 * ~a3 is not constant
 			// lhs = 9 * 8 = ~a4 * a4 is constant
 			else if (aa.rhs0 == aa.rhs1+1 && aa.rhs0 % 2 == 1)
-				trues_.insert (aa.lhs + 1);
+				trues_[aa.lhs + 1] = 1;
 		}
 	}
 
@@ -138,7 +152,14 @@ namespace car{
 	{
 		// contraints, outputs and latches gates are stored in order,
 		// as the need for start solver construction
-		std::unordered_set<unsigned> exist_gates, gates;
+		// exist_gates is indexed by aiger var.
+		std::vector<char> exist_gates (aig->maxvar + 1, 0);
+		std::vector<const aiger_and*> gates;
+
+		// 3 clauses for each gate at most, and a few for latches.
+		cls_offsets_.reserve (3 * aig->num_ands + 2 * aig->num_latches + 8);
+		cls_lits_.reserve (7 * aig->num_ands + 5 * aig->num_latches + 16);
+		cls_offsets_.push_back (0);
 
 
 		// ============================================================================
@@ -146,12 +167,7 @@ namespace car{
 		// ============================================================================
 		collect_necessary_gates(aig, aig->constraints, aig->num_constraints, exist_gates, gates);
 
-		for (std::unordered_set<unsigned>::iterator it = gates.begin(); it != gates.end(); it++)
-		{
-			aiger_and *aa = aiger_is_and(const_cast<aiger *>(aig), *it);
-			assert(aa != NULL);
-			add_clauses_from_equation(aa);
-		}
+		encode_gates(gates, aig);
 
 		// ============================================================================
 		// (2) same next have same previous, initialized to 0.
@@ -175,12 +191,7 @@ namespace car{
 		gates.clear();
 		//  Use Outputs as the start point, recursively add all the rhs lits.
 		collect_necessary_gates(aig, aig->outputs, aig->num_outputs, exist_gates, gates);
-		for (std::unordered_set<unsigned>::iterator it = gates.begin(); it != gates.end(); it++)
-		{
-			aiger_and *aa = aiger_is_and(const_cast<aiger *>(aig), *it);
-			assert(aa != NULL);
-			add_clauses_from_equation(aa);
-		}
+		encode_gates(gates, aig);
 
 		// ============================================================================
 		// (4) clause for encoding latches's mapping relation
@@ -192,18 +203,13 @@ namespace car{
 		//  Use Next value of Latches as the start point, recursively add all the rhs lits.
 		gates.clear();
 		collect_necessary_gates(aig, aig->latches, aig->num_latches, exist_gates, gates, true);
-		for (std::unordered_set<unsigned>::iterator it = gates.begin(); it != gates.end(); it++)
-		{
-			aiger_and *aa = aiger_is_and(const_cast<aiger *>(aig), *it);
-			assert(aa != NULL);
-			add_clauses_from_equation(aa);
-		}
+		encode_gates(gates, aig);
 
 		// ============================================================================
 		//// (5) create clauses for true and false
 		// ============================================================================
-		cls_.push_back(clause(true_));
-		cls_.push_back(clause(-false_));
+		add_clause ({true_});
+		add_clause ({-false_});
 	}
 
 	/**
@@ -232,29 +238,29 @@ namespace car{
 			exist = true;
 			for (int i = 0; i < v.size() - 1; i++)
 			{
-				cls_.push_back({v[i], -v[i + 1], -flag1});
-				cls_.push_back({-v[i], v[i + 1], -flag1});
+				add_clause ({v[i], -v[i + 1], -flag1});
+				add_clause ({-v[i], v[i + 1], -flag1});
 			}
 		}
 		if (!exist)
 		{
 			// at last add one clause for flag1 so that the sat solver will not treat flag1 as one literal
-			cls_.push_back({++max_id_, -flag1});
+			add_clause ({++max_id_, -flag1});
 		}
 
 		// add initial state
 		int flag2 = ++max_id_;
 		for (int i = 0; i < init_.size(); i++)
 		{
-			cls_.push_back({init_[i], -flag2});
+			add_clause ({init_[i], -flag2});
 		}
 		// either : all latches share a common next
 		// or : this is the initial states, all latches are initialized.
-		cls_.push_back({flag1, flag2});
+		add_clause ({flag1, flag2});
 	}
 
 	void Model::collect_necessary_gates (const aiger* aig, const aiger_symbol* as, const int as_size, 
-	                                        std::unordered_set<unsigned>& exist_gates, std::unordered_set<unsigned>& gates, bool next)
+	                                        std::vector<char>& exist_gates, std::vector<const aiger_and*>& gates, bool next)
 	{
 		for (int i = 0; i < as_size; i ++)
 		{
@@ -272,7 +278,7 @@ namespace car{
 			    		outputs_[i] = false_;
 			    }
 			}
-			recursively_add (aa, aig, exist_gates, gates);	
+			iteratively_add (aa, aig, exist_gates, gates);
 		}
 		
 	}
@@ -285,20 +291,51 @@ namespace car{
 		return NULL;
 	}
 	
-	void Model::recursively_add (const aiger_and* aa, const aiger* aig, std::unordered_set<unsigned>& exist_gates, std::unordered_set<unsigned>& gates)
+	/**
+	 * @brief encode the gates by decreasing lhs, that is, in reverse topological order: the gates next to the outputs and the next values first.
+	 * The search is sensitive to the clause order, and this one does best among the orders of the collected gates.
+	 * @note gates is sorted in place.
+	 */
+	void Model::encode_gates (std::vector<const aiger_and*>& gates, const aiger* aig)
+	{
+		std::sort (gates.begin (), gates.end (), [] (const aiger_and* a, const aiger_and* b) { return a->lhs > b->lhs; });
+		for (const aiger_and *aa : gates)
+			encode_gate (aa, aig);
+	}
+
+	/**
+	 * @brief collect all the gates in the cone of aa, which are not collected before.
+	 * @note an explicit stack is used, because the and-chain can be very deep.
+	 * 
+	 * @param aa 
+	 * @param aig 
+	 * @param exist_gates 
+	 * @param gates 
+	 */
+	void Model::iteratively_add (const aiger_and* aa, const aiger* aig, std::vector<char>& exist_gates, std::vector<const aiger_and*>& gates)
 	{
 		if (aa == NULL)
 			return;
-		if (exist_gates.find (aa->lhs) != exist_gates.end ())
-			return;
-		
-		gates.insert (aa->lhs);
-		exist_gates.insert (aa->lhs);
-		aiger_and* aa0 = necessary_gate (aa->rhs0, aig);
-		recursively_add (aa0, aig, exist_gates, gates);
-		
-		aiger_and* aa1 = necessary_gate (aa->rhs1, aig);
-		recursively_add (aa1, aig, exist_gates, gates);
+
+		// the same order as a recursive pre-order traversal: the gate, the cone of rhs0, then the cone of rhs1.
+		std::vector<const aiger_and*> todo = {aa};
+		while (!todo.empty ())
+		{
+			const aiger_and* top = todo.back ();
+			todo.pop_back ();
+			unsigned var = aiger_lit2var (top->lhs);
+			if (exist_gates[var])
+				continue;
+			exist_gates[var] = 1;
+			gates.push_back (top);
+
+			aiger_and* aa1 = necessary_gate (top->rhs1, aig);
+			if (aa1 != NULL && !exist_gates[aiger_lit2var (aa1->lhs)])
+				todo.push_back (aa1);
+			aiger_and* aa0 = necessary_gate (top->rhs0, aig);
+			if (aa0 != NULL && !exist_gates[aiger_lit2var (aa0->lhs)])
+				todo.push_back (aa0);
+		}
 	}
 	
 	/**
@@ -319,23 +356,180 @@ namespace car{
 			 * <=>	  lhs -> rhs1 /\ rhs1 -> lhs
 			 * <=>	  (~lhs \/ rhs1), (~rhs1, lhs)
 			 */
-			cls_.push_back (clause (car_var (aa->lhs), -car_var (aa->rhs1)));
-			cls_.push_back (clause (-car_var (aa->lhs), car_var (aa->rhs1)));
+			add_clause ({car_var (aa->lhs), -car_var (aa->rhs1)});
+			add_clause ({-car_var (aa->lhs), car_var (aa->rhs1)});
 		}
 		else if (is_true (aa->rhs1))
 		{
-			cls_.push_back (clause (car_var (aa->lhs), -car_var (aa->rhs0)));
-			cls_.push_back (clause (-car_var (aa->lhs), car_var (aa->rhs0)));
+			add_clause ({car_var (aa->lhs), -car_var (aa->rhs0)});
+			add_clause ({-car_var (aa->lhs), car_var (aa->rhs0)});
 		}
 		else
 		{
-			cls_.push_back (clause (car_var (aa->lhs), -car_var (aa->rhs0), -car_var (aa->rhs1)));
-			cls_.push_back (clause (-car_var (aa->lhs), car_var (aa->rhs0)));
-			cls_.push_back (clause (-car_var (aa->lhs), car_var (aa->rhs1)));
+			add_clause ({car_var (aa->lhs), -car_var (aa->rhs0), -car_var (aa->rhs1)});
+			add_clause ({-car_var (aa->lhs), car_var (aa->rhs0)});
+			add_clause ({-car_var (aa->lhs), car_var (aa->rhs1)});
 		}
 			
 	}
 	
+	void Model::encode_gate (const aiger_and* aa, const aiger* aig)
+	{
+		if (!polarity_aware_)
+		{
+			add_clauses_from_equation (aa);
+			return;
+		}
+		// it is encoded together with the only gate that uses it.
+		if (merged_[aiger_lit2var (aa->lhs)])
+			return;
+		add_clauses_from_tree (aa, aig);
+	}
+
+	/**
+	 * @brief Decide in which polarity each gate is used, starting from the roots:
+	 * 	next values of latches : both. States and UCs assign latches in both polarities, and the next values are also read back from the model.
+	 * 	outputs : only the one that makes bad true, because bad is only assumed.
+	 * 	constraints : both.
+	 * @pre the aiger is reencoded, therefore a gate is always after its children.
+	 */
+	void Model::compute_polarity (const aiger* aig)
+	{
+		int size = aig->maxvar + 1;
+		polarity_.assign (size, 0);
+		fanout_.assign (size, 0);
+		root_.assign (size, 0);
+		merged_.assign (size, 0);
+
+		for (int i = 0; i < aig->num_latches; i ++)
+		{
+			unsigned var = aiger_lit2var (aig->latches[i].next);
+			polarity_[var] |= POL_BOTH;
+			root_[var] = 1;
+		}
+		for (int i = 0; i < aig->num_outputs; i ++)
+		{
+			unsigned lit = aig->outputs[i].lit;
+			polarity_[aiger_lit2var (lit)] |= (lit % 2 == 0) ? POL_POS : POL_NEG;
+			root_[aiger_lit2var (lit)] = 1;
+		}
+		for (int i = 0; i < aig->num_constraints; i ++)
+		{
+			unsigned var = aiger_lit2var (aig->constraints[i].lit);
+			polarity_[var] |= POL_BOTH;
+			root_[var] = 1;
+		}
+
+		for (int i = 0; i < aig->num_ands; i ++)
+		{
+			aiger_and& aa = aig->ands[i];
+			fanout_[aiger_lit2var (aa.rhs0)] ++;
+			fanout_[aiger_lit2var (aa.rhs1)] ++;
+		}
+
+		// a positive, non-constant gate which is used only once and is not a root, is merged into its parent, as part of an n-ary and.
+		const unsigned first_and = aig->num_inputs + aig->num_latches + 1;
+		for (int i = 0; i < aig->num_ands; i ++)
+		{
+			aiger_and& aa = aig->ands[i];
+			unsigned rhs[2] = {aa.rhs0, aa.rhs1};
+			for (unsigned lit : rhs)
+			{
+				unsigned var = aiger_lit2var (lit);
+				if (lit % 2 == 1 || var < first_and || is_true (lit) || is_false (lit))
+					continue;
+				if (!root_[var] && fanout_[var] == 1)
+					merged_[var] = 1;
+			}
+		}
+
+		// parents first
+		for (int i = aig->num_ands - 1; i >= 0; i --)
+		{
+			aiger_and& aa = aig->ands[i];
+			unsigned char pol = polarity_[aiger_lit2var (aa.lhs)];
+			if (pol == 0)
+				continue;
+			// a negated child is used in the other polarity
+			unsigned char flipped = ((pol & POL_POS) ? POL_NEG : 0) | ((pol & POL_NEG) ? POL_POS : 0);
+			polarity_[aiger_lit2var (aa.rhs0)] |= (aa.rhs0 % 2 == 0) ? pol : flipped;
+			polarity_[aiger_lit2var (aa.rhs1)] |= (aa.rhs1 % 2 == 0) ? pol : flipped;
+		}
+	}
+
+	/**
+	 * @brief whether this literal is an edge into a gate merged into its parent.
+	 * 
+	 * @param lit 
+	 */
+	bool Model::absorbed (const unsigned lit)
+	{
+		return lit % 2 == 0 && merged_[aiger_lit2var (lit)];
+	}
+
+	/**
+	 * @brief collect the leaves of the and-tree rooted at aa, going through the absorbed gates.
+	 * 
+	 * @param aa 
+	 * @param aig 
+	 * @param leaves car literals. TRUE is left out.
+	 */
+	void Model::collect_leaves (const aiger_and* aa, const aiger* aig, vect& leaves)
+	{
+		vector<unsigned> todo = {aa->rhs1, aa->rhs0};
+		while (!todo.empty ())
+		{
+			unsigned lit = todo.back ();
+			todo.pop_back ();
+			if (is_true (lit))
+				continue;
+			if (absorbed (lit))
+			{
+				aiger_and* child = aiger_is_and (const_cast<aiger*> (aig), lit);
+				assert (child != NULL);
+				todo.push_back (child->rhs1);
+				todo.push_back (child->rhs0);
+				continue;
+			}
+			leaves.push_back (car_var (lit));
+		}
+	}
+
+	/**
+	 * @brief Plaisted-Greenbaum encoding of lhs = x1 /\ x2 /\ ... /\ xn
+	 * 	positive : (~lhs \/ xi) for each i
+	 * 	negative : (lhs \/ ~x1 \/ ... \/ ~xn)
+	 * 
+	 * @param aa 
+	 * @param aig 
+	 */
+	void Model::add_clauses_from_tree (const aiger_and* aa, const aiger* aig)
+	{
+		assert (aa != NULL);
+		assert (!is_true (aa->lhs) && !is_false (aa->lhs));
+
+		int lhs = car_var (aa->lhs);
+		unsigned char pol = polarity_[aiger_lit2var (aa->lhs)];
+		assert (pol != 0);
+
+		vect leaves;
+		collect_leaves (aa, aig, leaves);
+		assert (!leaves.empty ());
+
+		if (pol & POL_POS)
+		{
+			for (int i = 0; i < leaves.size (); i ++)
+				add_clause ({-lhs, leaves[i]});
+		}
+		if (pol & POL_NEG)
+		{
+			vect cl = {lhs};
+			for (int i = 0; i < leaves.size (); i ++)
+				cl.push_back (-leaves[i]);
+			add_clause (cl);
+		}
+	}
+
 	/**
 	 * @brief get the next id of given id
 	 * 
@@ -411,12 +605,247 @@ namespace car{
 	}
 	
 	
+	// ============================================================================
+	// preprocessing
+	// ============================================================================
+
+	/**
+	 * @brief SatELite-style preprocessing of the outputs (3) and latches (4) sections.
+	 * Sections (1) and (2) are loaded alone by some solvers, so they are kept as they are, and their vars are frozen.
+	 * Inputs, latches, next values, outputs, constraints and TRUE / FALSE are frozen as well, as solvers assume or read them.
+	 * The latches section is simplified first with the outputs section frozen, then the other way around,
+	 * so that no variable shared by the two sections gets eliminated.
+	 */
+	void Model::simplify ()
+	{
+		vector<char> frozen (max_id_ + 1, 0);
+		for (int v = 1; v <= num_inputs_ + num_latches_; v ++)
+			frozen[v] = 1;
+		for (auto& it : next_map_)
+			frozen[abs (it.second)] = 1;
+		for (int o : outputs_)
+			frozen[abs (o)] = 1;
+		for (int c : constraints_)
+			frozen[abs (c)] = 1;
+		frozen[true_] = frozen[false_] = 1;
+		freeze_section (0, outputs_start_, frozen);
+
+		vector<char> frozen_for_latches = frozen;
+		freeze_section (outputs_start_, latches_start_, frozen_for_latches);
+		vector<vect> latches;
+		if (!simplify_section (latches_start_, size () - 2, frozen_for_latches, latches))
+			return;
+
+		for (const vect& cl : latches)
+			for (int lit : cl)
+				frozen[abs (lit)] = 1;
+		vector<vect> outputs;
+		if (!simplify_section (outputs_start_, latches_start_, frozen, outputs))
+			return;
+
+		// rebuild the arena, in the same order of sections.
+		vect old_lits, old_offsets;
+		old_lits.swap (cls_lits_);
+		old_offsets.swap (cls_offsets_);
+		int old_size = old_offsets.size () - 1;
+		cls_offsets_.push_back (0);
+		for (int i = 0; i < outputs_start_; i ++)
+			add_clause (vect (old_lits.begin () + old_offsets[i], old_lits.begin () + old_offsets[i + 1]));
+		for (const vect& cl : outputs)
+			add_clause (cl);
+		set_latches_start ();
+		for (const vect& cl : latches)
+			add_clause (cl);
+		for (int i = old_size - 2; i < old_size; i ++)
+			add_clause (vect (old_lits.begin () + old_offsets[i], old_lits.begin () + old_offsets[i + 1]));
+	}
+
+	void Model::freeze_section (const int from, const int to, std::vector<char>& frozen)
+	{
+		for (int i = from; i < to; i ++)
+			for (int lit : element (i))
+				frozen[abs (lit)] = 1;
+	}
+
+	bool Model::simplify_section (const int from, const int to, const std::vector<char>& frozen, std::vector<vect>& res)
+	{
+		Preprocessor pre;
+		for (int v = 1; v < frozen.size (); v ++)
+			if (frozen[v])
+				pre.freeze (v);
+		for (int i = from; i < to; i ++)
+			pre.add_clause (element (i));
+		return pre.simplify (res);
+	}
+
+	// ============================================================================
+	// snapshot
+	// ============================================================================
+	// layout: magic, encoding, key, then the scalars and the arrays below, in this order.
+	// Each array is its size followed by the raw elements.
+
+	static const char SNAPSHOT_MAGIC[8] = {'C', 'A', 'R', 'S', 'N', 'P', '0', '2'};
+	// the version of the clauses built for a design. Bump it whenever the encoding changes (gate order, simplification...),
+	// so that the snapshots of an older encoding are built again.
+	// 2: the gates are encoded by decreasing lhs.
+	static const uint32_t SNAPSHOT_ENCODING = 2;
+
+	template <typename T>
+	static void write_array (ofstream& out, const std::vector<T>& v)
+	{
+		uint64_t sz = v.size ();
+		out.write ((const char*)&sz, sizeof (sz));
+		out.write ((const char*)v.data (), sz * sizeof (T));
+	}
+
+	template <typename T>
+	static bool read_array (const char*& p, const char* end, std::vector<T>& v)
+	{
+		uint64_t sz;
+		if (end - p < (long)sizeof (sz))
+			return false;
+		memcpy (&sz, p, sizeof (sz));
+		p += sizeof (sz);
+		if ((uint64_t)(end - p) / sizeof (T) < sz)
+			return false;
+		v.resize (sz);
+		memcpy (v.data (), p, sz * sizeof (T));
+		p += sz * sizeof (T);
+		return true;
+	}
+
+	bool Model::save_snapshot (const std::string& file, const uint64_t key) const
+	{
+		// written aside and renamed, so that a concurrent run never maps a partial file.
+		string tmp = file + ".tmp" + to_string (getpid ());
+		ofstream out (tmp.c_str (), ios::binary);
+		if (!out)
+			return false;
+
+		out.write (SNAPSHOT_MAGIC, sizeof (SNAPSHOT_MAGIC));
+		out.write ((const char*)&SNAPSHOT_ENCODING, sizeof (SNAPSHOT_ENCODING));
+		out.write ((const char*)&key, sizeof (key));
+
+		vect scalars = {polarity_aware_, num_inputs_, num_latches_, num_ands_, num_constraints_, num_outputs_,
+			max_model_id_, max_id_, true_, false_, common_next_start_, outputs_start_, latches_start_};
+		write_array (out, scalars);
+
+		vect next_of_latches (num_latches_);
+		for (int i = 0; i < num_latches_; i ++)
+			next_of_latches[i] = next_map_.at (num_inputs_ + 1 + i);
+
+		write_array (out, init_);
+		write_array (out, outputs_);
+		write_array (out, constraints_);
+		write_array (out, next_of_latches);
+		write_array (out, trues_);
+		write_array (out, cls_offsets_);
+		write_array (out, cls_lits_);
+		out.close ();
+
+		if (!out || rename (tmp.c_str (), file.c_str ()) != 0)
+		{
+			remove (tmp.c_str ());
+			return false;
+		}
+		return true;
+	}
+
+	Model* Model::load_snapshot (const std::string& file, const uint64_t key)
+	{
+		int fd = open (file.c_str (), O_RDONLY);
+		if (fd < 0)
+			return NULL;
+		struct stat st;
+		if (fstat (fd, &st) || st.st_size <= 0)
+		{
+			close (fd);
+			return NULL;
+		}
+		size_t bytes = st.st_size;
+		void* start = mmap (NULL, bytes, PROT_READ, MAP_PRIVATE, fd, 0);
+		close (fd);
+		if (start == MAP_FAILED)
+			return NULL;
+
+		const char* p = (const char*)start;
+		const char* end = p + bytes;
+		uint64_t stored_key = 0;
+		uint32_t stored_encoding = 0;
+		Model* res = new Model ();
+		vect scalars, next_of_latches;
+		bool ok = (bytes >= sizeof (SNAPSHOT_MAGIC) + sizeof (stored_encoding) + sizeof (key))
+			&& memcmp (p, SNAPSHOT_MAGIC, sizeof (SNAPSHOT_MAGIC)) == 0;
+		if (ok)
+		{
+			p += sizeof (SNAPSHOT_MAGIC);
+			memcpy (&stored_encoding, p, sizeof (stored_encoding));
+			p += sizeof (stored_encoding);
+			memcpy (&stored_key, p, sizeof (key));
+			p += sizeof (key);
+			ok = (stored_encoding == SNAPSHOT_ENCODING) && (stored_key == key)
+				&& read_array (p, end, scalars) && scalars.size () == 13
+				&& read_array (p, end, res->init_)
+				&& read_array (p, end, res->outputs_)
+				&& read_array (p, end, res->constraints_)
+				&& read_array (p, end, next_of_latches)
+				&& read_array (p, end, res->trues_)
+				&& read_array (p, end, res->cls_offsets_)
+				&& read_array (p, end, res->cls_lits_)
+				&& p == end;
+		}
+		munmap (start, bytes);
+
+		if (ok)
+		{
+			res->verbose_ = false;
+			res->polarity_aware_ = scalars[0];
+			res->num_inputs_ = scalars[1];
+			res->num_latches_ = scalars[2];
+			res->num_ands_ = scalars[3];
+			res->num_constraints_ = scalars[4];
+			res->num_outputs_ = scalars[5];
+			res->max_model_id_ = scalars[6];
+			res->max_id_ = scalars[7];
+			res->true_ = scalars[8];
+			res->false_ = scalars[9];
+			res->common_next_start_ = scalars[10];
+			res->outputs_start_ = scalars[11];
+			res->latches_start_ = scalars[12];
+			ok = next_of_latches.size () == res->num_latches_
+				&& !res->cls_offsets_.empty () && res->cls_offsets_.back () == res->cls_lits_.size ();
+		}
+		if (!ok)
+		{
+			delete res;
+			return NULL;
+		}
+		res->rebuild_next_map (next_of_latches);
+		return res;
+	}
+
+	/**
+	 * @brief the same maps as create_next_map() builds, from the next value of each latch.
+	 * 
+	 * @param next_of_latches 
+	 */
+	void Model::rebuild_next_map (const vect& next_of_latches)
+	{
+		for (int i = 0; i < num_latches_; i ++)
+		{
+			int val = num_inputs_ + 1 + i;
+			int next_val = next_of_latches[i];
+			next_map_.insert (std::pair<int, int> (val, next_val));
+			insert_to_reverse_next_map (abs (next_val), (next_val > 0) ? val : -val);
+		}
+	}
+
 	void Model::print ()
 	{
 	    cout << "-------------------Model information--------------------" << endl;
-	    cout << endl << "number of clauses: " << cls_.size () << endl;
-	    for (int i  = 0; i < cls_.size (); i ++)
-	        car::print (cls_[i]);
+	    cout << endl << "number of clauses: " << size () << endl;
+	    for (int i  = 0; i < size (); i ++)
+	        car::print (vect (element (i).begin (), element (i).end ()));
 	    cout << endl << "next map: " << endl;
 	    car::print (next_map_);
 	    cout << endl << "reverse next map:" << endl;
@@ -432,8 +861,13 @@ namespace car{
 	    cout << endl << "Max id used: " << max_id_ << endl;
 	    cout << endl << "outputs start index: " << outputs_start_ << endl;
 	    cout << endl << "latches start index: " << latches_start_ << endl;
-	    cout << endl << "number of TRUE variables: " << trues_.size () << endl;
-	    car::print (trues_); 
+	    cout << endl << "polarity aware: " << (polarity_aware_ ? "yes" : "no") << endl;
+	    vect trues;
+	    for (unsigned lit = 0; lit < trues_.size (); lit ++)
+	        if (trues_[lit])
+	            trues.push_back (lit);
+	    cout << endl << "number of TRUE variables: " << trues.size () << endl;
+	    car::print (trues); 
 	    cout << endl << "-------------------End of Model information--------------------" << endl;   
 	}
 }
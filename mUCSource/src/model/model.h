@@ -7,14 +7,23 @@ extern "C" {
 #include "assert.h"
 #include "basic_data.h"
 #include <unordered_map>
-#include <unordered_set>
+#include <string>
+#include <cstdint>
 
 
 namespace car {
 class Model {
 public:
-	Model (aiger*, const bool verbose = false);
+	Model (aiger*, const bool verbose = false, const bool polarity_aware = false, const bool simplify = false);
 	~Model () {}
+
+	/**
+	 * @brief snapshot of the fully built model (clauses, next map, init, outputs),
+	 * so that later runs on the same design can skip parsing and encoding.
+	 * `load_snapshot` returns NULL if the file is missing or does not match.
+	 */
+	bool save_snapshot (const std::string& file, const uint64_t key) const;
+	static Model* load_snapshot (const std::string& file, const uint64_t key);
 	
 	int prime (const int);
 	std::vector<int> previous (const int);
@@ -31,14 +40,17 @@ public:
 	inline int outputs_start() const { return outputs_start_; }
 	inline int common_next_start() const { return common_next_start_; }
 	inline int latches_start() const { return latches_start_; }
-	inline int size() const { return cls_.size(); }
+	inline int size() const { return cls_offsets_.size() - 1; }
 	std::vector<std::vector<int>> output_clauses()
 	{
 		// FIXME: Is this right?
 		assert(latches_start_ > outputs_start_);
-		return std::vector<car::Cube>(cls_.begin() + outputs_start_, cls_.begin() + latches_start_);
+		std::vector<car::Cube> res;
+		for (int i = outputs_start_; i < latches_start_; ++i)
+			res.emplace_back(element(i).begin(), element(i).end());
+		return res;
 	};
-	inline std::vector<int>& element (const int id) {return cls_[id];}
+	inline ClauseView element (const int id) const {return ClauseView{cls_lits_.data() + cls_offsets_[id], cls_offsets_[id+1] - cls_offsets_[id]};}
 	inline int output (const int id)const  {return outputs_[id];}
 	
 	// return initial values for latches
@@ -55,8 +67,11 @@ public:
 
 	
 private:
+	Model () {}
+
 	//members
 	bool verbose_;
+	bool polarity_aware_; // Plaisted-Greenbaum encoding, with and-trees merged.
 	
 	
 	int num_inputs_;
@@ -74,22 +89,23 @@ private:
 	int false_;  //id for false
 	
 	typedef std::vector<int> vect;
-	typedef std::vector<vect> Clauses;
 	
 	vect init_;   //initial values for latches
 	vect outputs_; //output ids
 	vect constraints_; //constraint ids
 public:
-	Clauses cls_;  //set of clauses, it contains three parts:
+	// set of clauses, stored flat: clause i is cls_lits_[cls_offsets_[i], cls_offsets_[i+1]). It contains these parts:
 	                //(1) clauses for constraints, i.e. those before position outputs_start_;
 	                //(2) same next have same previous, initialized to 0.
 					//(3) clauses for outputs, i.e. those before position latches_start_;
 	                //(4) clauses for latches 
 					//(5) clause for encoding our FALSE / TRUE
+	vect cls_lits_;
+	vect cls_offsets_;
 	
 	int common_next_start_;
-	int outputs_start_; //the index of cls_ to point the start position of outputs
-	int latches_start_; //the index of cls_ to point the start position of latches
+	int outputs_start_; //the index of clauses to point the start position of outputs
+	int latches_start_; //the index of clauses to point the start position of latches
 
 	
 	typedef std::unordered_map<int, int> nextMap;
@@ -98,19 +114,30 @@ public:
 	reverseNextMap reverse_next_map_;  //map from the next values of latches to latches
 	                                   //BE careful the situation when next (a) = c and next (b) = c!!
 	
-	std::unordered_set<unsigned> trues_;  //vars evaluated to be true, and their negation is false
+	std::vector<char> trues_;  //indexed by aiger literal: evaluated to be true, and their negation is false
+
+	// polarity-aware encoding relevant, indexed by aiger var.
+	enum PolarityEnum{
+		POL_POS = 1, // gate -> its children
+		POL_NEG = 2, // its children -> gate
+		POL_BOTH = 3
+	};
+	std::vector<unsigned char> polarity_; // in which polarity the gate is used
+	std::vector<int> fanout_;             // how many gates use it as a child
+	std::vector<char> root_;              // outputs, constraints and next values of latches
+	std::vector<char> merged_;            // merged into the only gate that uses it, see `absorbed()`
 	
 	
 	//functions
 
 	inline bool is_true (const unsigned id)
 	{
-		return (id == 1) || (trues_.find (id) != trues_.end ());
+		return (id == 1) || trues_[id];
 	}
 	
 	inline bool is_false (const unsigned id)
 	{
-		return (id == 0) || (trues_.find ((id % 2 == 0) ? (id+1) : (id-1)) != trues_.end ());
+		return (id == 0) || trues_[id ^ 1];
 	}
 	
 	inline int car_var (const unsigned id)
@@ -119,47 +146,57 @@ public:
 		return ((id % 2 == 0) ? (id/2) : -(id/2));
 	}
 	
-	inline vect clause (int id)
+	// append one clause to the arena
+	inline void add_clause (std::initializer_list<int> cl)
 	{
-		return (vect){id};
+		cls_lits_.insert (cls_lits_.end (), cl.begin (), cl.end ());
+		cls_offsets_.push_back (cls_lits_.size ());
 	}
-	
-	inline vect clause (int id1, int id2)
-	{
-		return (vect){id1, id2};
-	}
-	
-	inline vect clause (int id1, int id2, int id3)
+
+	inline void add_clause (const vect& cl)
 	{
-		return (vect){id1, id2, id3};
+		cls_lits_.insert (cls_lits_.end (), cl.begin (), cl.end ());
+		cls_offsets_.push_back (cls_lits_.size ());
 	}
 	
 	inline void set_outputs_start ()
 	{
-	    outputs_start_ = cls_.size ();
+	    outputs_start_ = size ();
 	}
 	
 	inline void set_latches_start ()
 	{
-	    latches_start_ = cls_.size ();
+	    latches_start_ = size ();
 	}
 
 	inline void set_common_next_start()
 	{
-		common_next_start_ = cls_.size();
+		common_next_start_ = size();
 	}
 	
 	void collect_trues (const aiger* aig);
 	void create_next_map (const aiger* aig);
 	void create_clauses (const aiger* aig);
-	void collect_necessary_gates (const aiger* aig, const aiger_symbol* as, const int as_size, std::unordered_set<unsigned>& exist_gates, std::unordered_set<unsigned>& gates, bool next = false);
+	void collect_necessary_gates (const aiger* aig, const aiger_symbol* as, const int as_size, std::vector<char>& exist_gates, std::vector<const aiger_and*>& gates, bool next = false);
 	aiger_and* necessary_gate (const unsigned id, const aiger* aig);
-	void recursively_add (const aiger_and* aa, const aiger* aig, std::unordered_set<unsigned>& exist_gates, std::unordered_set<unsigned>& gates);
+	void iteratively_add (const aiger_and* aa, const aiger* aig, std::vector<char>& exist_gates, std::vector<const aiger_and*>& gates);
 	void add_clauses_from_equation (const aiger_and* aa);
+	void encode_gate (const aiger_and* aa, const aiger* aig);
+	void encode_gates (std::vector<const aiger_and*>& gates, const aiger* aig);
+	
+	void compute_polarity (const aiger* aig);
+
+	void simplify ();
+	bool simplify_section (const int from, const int to, const std::vector<char>& frozen, std::vector<vect>& res);
+	void freeze_section (const int from, const int to, std::vector<char>& frozen);
+	bool absorbed (const unsigned lit);
+	void collect_leaves (const aiger_and* aa, const aiger* aig, vect& leaves);
+	void add_clauses_from_tree (const aiger_and* aa, const aiger* aig);
 	void set_init (const aiger* aig);
 	void set_constraints (const aiger* aig);
 	void set_outputs (const aiger* aig);
 	void insert_to_reverse_next_map (const int index, const int val);
+	void rebuild_next_map (const vect& next_of_latches);
 	void create_constraints_for_latches ();
 	
 	
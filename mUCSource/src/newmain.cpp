@@ -1,15 +1,21 @@
 #include "carChecker.h"
+#include "autoconfig.h"
 #include "bmcChecker.h"
 #include "statistics.h"
 #include "data_structure.h"
 #include "implysolver.h"
 #include "model.h"
+#include "coi.h"
+#include "utility.h"
 #include <stdlib.h>
 #include <stdio.h>
 #include <string.h>
 #include <iostream>
 #include <fstream>
+#include <sstream>
 #include <signal.h>
+#include <unistd.h>
+#include <thread>
 #include <assert.h>
 using namespace std;
 using namespace car;
@@ -27,8 +33,15 @@ namespace car
     const aiger *State::aig_;
 }
 
-void signal_handler(int sig_num)
+/**
+ * @brief SIGINT and SIGTERM are blocked in all the threads and taken here, by a thread of their own.
+ * A handler could stop a thread in the middle of malloc, and then hang on its lock when it prints (--mic-async, --div).
+ */
+void signal_waiter(sigset_t signals)
 {
+    int sig_num;
+    if (sigwait(&signals, &sig_num) != 0)
+        return;
     CARStats.stop_everything();
     if (dot_file.is_open())
     {
@@ -47,7 +60,10 @@ void signal_handler(int sig_num)
         dive_file.close();
     }
     CARStats.print();
-    exit(0);
+    cout.flush();
+    fflush(stdout);
+    // the other threads are still running, exit() would destroy what they use.
+    _exit(0);
 }
 
 void print_usage()
@@ -60,6 +76,43 @@ void print_usage()
     printf("       -v          print verbose information (Default = off)\n");
     printf("       -h          print help information\n");
     printf("       -vb         reproduce the mUC result\n");
+    printf("       --imp <n>   implication check: 0 manual, 1 solver, 2 sample, 3 sorted, 5 threshold, 6 MOM, 7 bandit per level (Default = 0)\n");
+    printf("       --imply-sat check blocking of --imp 1, 5 and 6 by a budgeted SAT call, instead of unit propagation (Default = off)\n");
+    printf("       --coi       reduce the model to the cone of influence of the property (Default = off)\n");
+    printf("       --pg        polarity-aware (Plaisted-Greenbaum) encoding of the model (Default = off)\n");
+    printf("       --simp      SatELite-style preprocessing of the transition relation (Default = off)\n");
+    printf("       --cache <dir>  reuse the snapshot of the built model in <dir>, or create it (Default = off)\n");
+    printf("       --sat <b>   SAT backend of all the solvers: glucose, glucose4 or minisat (Default = the one chosen by SOLVER when building)\n");
+    printf("       --sat-main|--sat-imply|--sat-inv|--sat-start|--sat-partial <b>\n");
+    printf("                   SAT backend of one solver, it overrides --sat\n");
+    printf("       --ass <o>   order of the assumption: IRRI, IIRR, IRIR, RIRI, RRII or RIIR (Default = I..IRR)\n");
+    printf("       --score     order the state by the scores of literals in failed states (Default = off)\n");
+    printf("       --score-rev|--score-abs|--score-decay  variants of --score: low to high, per variable, growing bumps\n");
+    printf("       --pqueue    pick the state to try with a priority queue (Default = a stack)\n");
+    printf("       --partial   partial states in forward search (Default = off)\n");
+    printf("       --fresh-uc  remove the UCs implied by a new one (Default = off)\n");
+    printf("       --last-first  put the last literal of an intersection first (Default = off)\n");
+    printf("       --front-flag  append the first literal of the UC, instead of the last one (Default = off)\n");
+    printf("       --depth     limit the target level by the depth of the state (Default = off)\n");
+    printf("       --inc-sat   incremental mode of glucose in the main solver (Default = off)\n");
+    printf("       --trail     print the search trail (Default = off)\n");
+    printf("       (the defaults of the options from --ass on can be changed by the Makefile knobs of the same names)\n");
+    printf("       --restart-policy <p>  restart every --restart seconds (time), or after luby or geom intervals of --restart-unit queries (Default = time)\n");
+    printf("       --restart-unit <n>  the unit of luby and geom, in queries of the main solver (Default = 1000)\n");
+    printf("       --retain <p>  with --rem 5, keep the p%% most active UCs of each frame on a restart (Default = 50)\n");
+    printf("       --batch <n> ask whether any of the next n states of U has a successor in the top frame with one query, before trying them one by one (Default = 1)\n");
+    printf("       --succ <k>  take up to k distinct successors from each SAT query of the main solver, and try them all (Default = 1)\n");
+    printf("       --reuse     before a query of the main solver, reuse the successor found for the state the last time, if the target frame does not block it (Default = off)\n");
+    printf("       --warm      with --restart, go on with the same frames, U sequences and solvers under the next --convParam, instead of a new checker (Default = off)\n");
+    printf("       --frame-budget <n>  drop the cold UCs of the frames down to n/2 when they hold more than n UCs in all (Default = 0, no limit)\n");
+    printf("       --mem-budget <m>  halve the frames when the process takes more than m MB, again once they have grown back (Default = 0, no limit)\n");
+    printf("       --div <n>   with --convMode, also try n clones of the main solver for another UC in parallel, and keep the shortest (Default = 0)\n");
+    printf("       --mic <n>   try to drop up to n literals from each UC, by a query of the same frame (Default = 0)\n");
+    printf("       --mic-async <n>  the same as --mic, on a background thread. The search does not wait for it (Default = 0)\n");
+    printf("       --mic-budget <p>  propagations of each try of --mic (Default = 10000)\n");
+    printf("       --auto      choose --imp, --convMode/--convParam, --inter, --rotate and the direction by probing the instance,\n");
+    printf("                   the options given on the command line are kept (Default = off)\n");
+    printf("       --auto-rules <file>  the rule table of --auto, see src/checker/autoconfig.h (Default = the built-in one)\n");
     exit(1);
 }
 
@@ -89,7 +142,6 @@ void check_aiger(int argc, char **argv)
 {
     bool forward = false;
     bool evidence = false;
-    bool propagate = false;
     bool enable_draw = false;
     bool enable_dive = false;
     bool bmc = false;
@@ -103,6 +155,17 @@ void check_aiger(int argc, char **argv)
     int impMethod=0;
     int time_limit_to_restart = -1;
     int rememOption = 0;
+    bool enable_coi = false;
+    bool polarity_aware = false;
+    bool simplify = false;
+    string cache_dir;
+    Strategy strategy;
+    SatBackendKind sat_all = default_backend();
+    map<int, SatBackendKind> sat_of_role;
+    bool enable_auto = false;
+    string auto_rules;
+    // the options that --auto keeps, see AutoOption.
+    int auto_fixed = 0;
 
     string input;
     string output_dir;
@@ -119,13 +182,20 @@ void check_aiger(int argc, char **argv)
             forward = false;
             evidence = true;
             impMethod = 5;
+            auto_fixed |= AUTO_IMP | AUTO_INTER | AUTO_ROTATE | AUTO_DIR;
         }
         else if (strcmp(argv[i], "-f") == 0)
+        {
             forward = true;
+            auto_fixed |= AUTO_DIR;
+        }
         else if (strcmp(argv[i], "-b") == 0)
+        {
             forward = false;
+            auto_fixed |= AUTO_DIR;
+        }
         else if (strcmp(argv[i], "-p") == 0)
-            propagate = true;
+            strategy.propagate = true;
         else if (strcmp(argv[i], "-v") == 0)
         {
             verbose = true;  // used outside checker
@@ -138,12 +208,14 @@ void check_aiger(int argc, char **argv)
         else if (strcmp(argv[i], "--rotate") == 0)
         {
             enable_rotate=true;
+            auto_fixed |= AUTO_ROTATE;
         }
         else if (strcmp(argv[i], "--inter") == 0)
         {
             assert(i+1<argc);
             ++i;
             inter_cnt = atoi(argv[i]);
+            auto_fixed |= AUTO_INTER;
         }
         else if (strcmp(argv[i], "--restart") == 0)
         {
@@ -151,6 +223,66 @@ void check_aiger(int argc, char **argv)
             ++i;
             time_limit_to_restart = atoi(argv[i]);
         }
+        else if (strcmp(argv[i], "--restart-policy") == 0)
+        {
+            if (i+1 >= argc)
+                print_usage();
+            ++i;
+            if (strcmp(argv[i], "luby") == 0)
+                strategy.restart_kind = Restart_Luby;
+            else if (strcmp(argv[i], "geom") == 0)
+                strategy.restart_kind = Restart_Geometric;
+            else if (strcmp(argv[i], "time") == 0)
+                strategy.restart_kind = Restart_Time;
+            else
+                print_usage();
+        }
+        else if (strcmp(argv[i], "--restart-unit") == 0)
+        {
+            if (i+1 >= argc)
+                print_usage();
+            ++i;
+            strategy.restart_unit = atol(argv[i]);
+        }
+        else if (strcmp(argv[i], "--retain") == 0)
+        {
+            if (i+1 >= argc)
+                print_usage();
+            ++i;
+            strategy.retain_percent = atoi(argv[i]);
+        }
+        else if (strcmp(argv[i], "--frame-budget") == 0)
+        {
+            if (i+1 >= argc)
+                print_usage();
+            ++i;
+            strategy.frame_budget = atol(argv[i]);
+        }
+        else if (strcmp(argv[i], "--mem-budget") == 0)
+        {
+            if (i+1 >= argc)
+                print_usage();
+            ++i;
+            strategy.mem_budget = atol(argv[i]);
+        }
+        else if (strcmp(argv[i], "--warm") == 0)
+            strategy.warm_restart = true;
+        else if (strcmp(argv[i], "--batch") == 0)
+        {
+            if (i+1 >= argc)
+                print_usage();
+            ++i;
+            strategy.batch_states = atoi(argv[i]);
+        }
+        else if (strcmp(argv[i], "--succ") == 0)
+        {
+            if (i+1 >= argc)
+                print_usage();
+            ++i;
+            strategy.batch_successors = atoi(argv[i]);
+        }
+        else if (strcmp(argv[i], "--reuse") == 0)
+            strategy.reuse_successor = true;
         else if (strcmp(argv[i], "--rem") == 0)
         {
             assert(i+1<argc);
@@ -175,6 +307,7 @@ void check_aiger(int argc, char **argv)
             assert(i+1<argc);
             ++i;
             impMethod = atoi(argv[i]);
+            auto_fixed |= AUTO_IMP;
         }
         else if (strcmp(argv[i], "--incomplete") == 0)
         {
@@ -190,12 +323,126 @@ void check_aiger(int argc, char **argv)
             assert(i+1<argc);
             ++i;
             convMode = atoi(argv[i]);
+            auto_fixed |= AUTO_CONV;
         }
         else if (strcmp(argv[i], "--convParam") == 0)
         {
             assert(i+1<argc);
             ++i;
             convParam = atoi(argv[i]);
+            auto_fixed |= AUTO_CONV;
+        }
+        else if (strcmp(argv[i], "--coi") == 0)
+        {
+            enable_coi = true;
+        }
+        else if (strcmp(argv[i], "--pg") == 0)
+        {
+            polarity_aware = true;
+        }
+        else if (strcmp(argv[i], "--simp") == 0)
+        {
+            simplify = true;
+        }
+        else if (strcmp(argv[i], "--cache") == 0)
+        {
+            assert(i+1<argc);
+            ++i;
+            cache_dir = string(argv[i]);
+        }
+        else if (strncmp(argv[i], "--sat", 5) == 0)
+        {
+            static const char *role_names[ROLE_NUM] = {"main", "imply", "inv", "start", "partial"};
+            int role = -1;
+            for (int r = 0; r < ROLE_NUM; ++r)
+                if (argv[i][5] == '-' && strcmp(argv[i] + 6, role_names[r]) == 0)
+                    role = r;
+            SatBackendKind kind;
+            if ((argv[i][5] != '\0' && role < 0) || i+1 >= argc || !parse_backend(argv[i+1], kind))
+                print_usage();
+            ++i;
+            if (role >= 0)
+                sat_of_role[role] = kind;
+            else
+                sat_all = kind;
+        }
+        else if (strcmp(argv[i], "--ass") == 0)
+        {
+            static const char *order_names[] = {"", "IRRI", "IIRR", "IRIR", "RIRI", "RRII", "RIIR"};
+            if (i+1 >= argc)
+                print_usage();
+            ++i;
+            int order = 0;
+            for (int o = Ass_IRRI; o <= Ass_RIIR; ++o)
+                if (strcmp(argv[i], order_names[o]) == 0)
+                    order = o;
+            if (order == 0)
+                print_usage();
+            strategy.ass_order = AssumOrder(order);
+        }
+        else if (strcmp(argv[i], "--score") == 0)
+            strategy.score = true;
+        else if (strcmp(argv[i], "--score-rev") == 0)
+            strategy.score_reverse = true;
+        else if (strcmp(argv[i], "--score-abs") == 0)
+            strategy.score_abs = true;
+        else if (strcmp(argv[i], "--score-decay") == 0)
+            strategy.score_decay = true;
+        else if (strcmp(argv[i], "--pqueue") == 0)
+            strategy.pqueue = true;
+        else if (strcmp(argv[i], "--partial") == 0)
+            strategy.partial = true;
+        else if (strcmp(argv[i], "--fresh-uc") == 0)
+            strategy.fresh_uc = true;
+        else if (strcmp(argv[i], "--last-first") == 0)
+            strategy.last_first = true;
+        else if (strcmp(argv[i], "--front-flag") == 0)
+            strategy.front_flag = true;
+        else if (strcmp(argv[i], "--depth") == 0)
+            strategy.depth = true;
+        else if (strcmp(argv[i], "--inc-sat") == 0)
+            strategy.inc_sat = true;
+        else if (strcmp(argv[i], "--trail") == 0)
+            strategy.trail = true;
+        else if (strcmp(argv[i], "--div") == 0)
+        {
+            if (i+1 >= argc)
+                print_usage();
+            ++i;
+            strategy.div_workers = atoi(argv[i]);
+        }
+        else if (strcmp(argv[i], "--mic") == 0)
+        {
+            if (i+1 >= argc)
+                print_usage();
+            ++i;
+            strategy.mic_attempts = atoi(argv[i]);
+        }
+        else if (strcmp(argv[i], "--mic-async") == 0)
+        {
+            if (i+1 >= argc)
+                print_usage();
+            ++i;
+            strategy.mic_async = atoi(argv[i]);
+        }
+        else if (strcmp(argv[i], "--mic-budget") == 0)
+        {
+            if (i+1 >= argc)
+                print_usage();
+            ++i;
+            strategy.mic_budget = atol(argv[i]);
+        }
+        else if (strcmp(argv[i], "--imply-sat") == 0)
+            ImplySolver::set_bcp(false);
+        else if (strcmp(argv[i], "--auto") == 0)
+            enable_auto = true;
+        else if (strcmp(argv[i], "--auto-rules") == 0)
+        {
+            if (i+1 >= argc)
+                print_usage();
+            ++i;
+            enable_auto = true;
+            auto_rules = string(argv[i]);
         }
         else if (!input_set)
         {
@@ -212,6 +459,8 @@ void check_aiger(int argc, char **argv)
     }
     if (!input_set || !output_dir_set)
         print_usage();
+    for (int r = 0; r < ROLE_NUM; ++r)
+        CARSolver::set_backend(SolverRole(r), sat_of_role.count(r) ? sat_of_role[r] : sat_all);
 
     if (output_dir.at(output_dir.size() - 1) != '/')
         output_dir += "/";
@@ -228,33 +477,82 @@ void check_aiger(int argc, char **argv)
     ofstream res_file;
     res_file.open(res_file_name.c_str());
     ofstream trail_file;
-#ifdef TRAIL
-    trail_file.open(trial_name.c_str());
-#endif
+    if (strategy.trail)
+        trail_file.open(trial_name.c_str());
 
     if (enable_draw)
         dot_file.open(dot_name.c_str());
     if (enable_dive)
         dive_file.open(dive_name.c_str());
 
-    // get aiger object
-    aiger *aig = aiger_init();
-    aiger_open_and_read_from_file(aig, input.c_str());
-    const char *err = aiger_error(aig);
-    if (err)
+    // partial states in forward search are calculated with ~bad assumed, which needs the full encoding.
+    if (strategy.partial && forward)
+        polarity_aware = false;
+    // the model is built before --auto picks the direction, do not let it go forward on a partial encoding.
+    if (strategy.partial && polarity_aware)
+        auto_fixed |= AUTO_DIR;
+
+    // a snapshot of the built model, keyed by the content of the input and the options that change the encoding.
+    Model *model = nullptr;
+    string snapshot_file;
+    uint64_t snapshot_key = 0;
+    if (!cache_dir.empty())
     {
-        printf("read aiger file error!\n");
-        // throw InputError(err);
-        exit(0);
+        snapshot_key = hash_file(input) ^ (uint64_t(simplify) << 2) ^ (uint64_t(enable_coi) << 1) ^ uint64_t(polarity_aware);
+        stringstream ss;
+        ss << cache_dir << (cache_dir.back() == '/' ? "" : "/") << filename << "." << hex << snapshot_key << ".model";
+        snapshot_file = ss.str();
+        model = Model::load_snapshot(snapshot_file, snapshot_key);
     }
-    if (!aiger_is_reencoded(aig))
-        aiger_reencode(aig);
 
-    Model *model = new Model(aig);
+    // the aiger is still needed with coi, to lift the witness back.
+    aiger *aig = nullptr;
+    if (model == nullptr || enable_coi)
+    {
+        // get aiger object
+        aig = aiger_init();
+        // binary files are mapped and decoded in place; anything else (ascii, compressed, justice...) goes through the generic reader.
+        if (aiger_mmap_read_binary(aig, input.c_str()))
+        {
+            aiger_reset(aig);
+            aig = aiger_init();
+            aiger_open_and_read_from_file(aig, input.c_str());
+        }
+        const char *err = aiger_error(aig);
+        if (err)
+        {
+            printf("read aiger file error!\n");
+            // throw InputError(err);
+            exit(0);
+        }
+        if (!aiger_is_reencoded(aig))
+            aiger_reencode(aig);
+    }
+
+    // the aiger that the model is built from. It is the reduced one if coi is enabled.
+    aiger *model_aig = aig;
+    COI *coi = nullptr;
+    // witness of the reduced model, to be lifted before printed into res_file.
+    stringstream coi_witness;
+    if (enable_coi)
+    {
+        coi = new COI(aig);
+        model_aig = coi->reduced();
+        if (verbose)
+            coi->print();
+    }
+    ostream &res_out = coi ? static_cast<ostream &>(coi_witness) : static_cast<ostream &>(res_file);
+
+    if (model == nullptr)
+    {
+        model = new Model(model_aig, false, polarity_aware, simplify);
+        if (!snapshot_file.empty())
+            model->save_snapshot(snapshot_file, snapshot_key);
+    }
     // FIXME: collect all these static members. unify them.
     car::model = model;
     State::model_ = model;
-    State::aig_ = aig;
+    State::aig_ = model_aig;
 
     if (verbose)
         model->print();
@@ -269,19 +567,45 @@ void check_aiger(int argc, char **argv)
     {
         auto bchker = new bmc::BMCChecker(model);
         bchker->check();
-        bchker->printEvidence(res_file);
+        bchker->printEvidence(res_out);
+        if (coi)
+            coi->lift_witness(coi_witness, res_file);
         return;
     }
     std::set<car::Checker *> to_clean;
 
-    if(time_limit_to_restart > 0)
+    if (enable_auto)
+    {
+        AutoConfig auto_config;
+        if (!auto_rules.empty() && !auto_config.load(auto_rules))
+        {
+            printf("read rule table error!\n");
+            exit(0);
+        }
+        InstanceFeatures features = AutoConfig::probe(model);
+        AutoChoice choice{impMethod, convMode, convParam, inter_cnt, enable_rotate, forward};
+        auto_config.choose(features, choice, auto_fixed);
+        impMethod = choice.impMethod;
+        convMode = choice.convMode;
+        convParam = choice.convParam;
+        inter_cnt = choice.inter_cnt;
+        enable_rotate = choice.rotate;
+        forward = choice.forward;
+        if (verbose)
+        {
+            features.print(cout);
+            choice.print(cout);
+        }
+    }
+
+    if(time_limit_to_restart > 0 || strategy.restart_kind != Restart_Time)
     {
         assert(convMode >=0);
         CARStats.count_whole_begin();
 
         // construct the checker
         // cout << "strategy is : convParam = " << convParam << endl;
-        chk = new Checker(time_limit_to_restart, model, res_file, trail_file, dot_file, dive_file, enable_dive, forward, evidence, 0, convMode, convParam,enable_rotate, inter_cnt, inv_incomplete, raw_uc, impMethod);
+        chk = new Checker(time_limit_to_restart, model, res_out, trail_file, dot_file, dive_file, enable_dive, forward, evidence, 0, convMode, convParam,enable_rotate, inter_cnt, inv_incomplete, raw_uc, impMethod, strategy);
         auto clear_delay = chk;// last checker may be used to pass information.
         bool res = chk->check();
         while (chk->ppstoped)
@@ -291,7 +615,7 @@ void check_aiger(int argc, char **argv)
             ImplySolver::reset_all();
             CARStats.reset_imply_cnter(); // reset
 
-            chk = new Checker(time_limit_to_restart, clear_delay, rememOption, model, res_file, trail_file, dot_file, dive_file, enable_dive, forward, evidence, 0, convMode, convParam,enable_rotate, inter_cnt, inv_incomplete, raw_uc, impMethod);
+            chk = new Checker(time_limit_to_restart, clear_delay, rememOption, model, res_out, trail_file, dot_file, dive_file, enable_dive, forward, evidence, 0, convMode, convParam,enable_rotate, inter_cnt, inv_incomplete, raw_uc, impMethod, strategy);
             
             // cout << "strategy is : convParam = " << convParam << endl;
             res = chk->check();
@@ -304,7 +628,7 @@ void check_aiger(int argc, char **argv)
 
     }
     else{
-        chk = new Checker(model, res_file, trail_file, dot_file, dive_file, enable_dive, forward, evidence, 0, convMode, convParam,enable_rotate, inter_cnt, inv_incomplete, raw_uc, impMethod);
+        chk = new Checker(model, res_out, trail_file, dot_file, dive_file, enable_dive, forward, evidence, 0, convMode, convParam,enable_rotate, inter_cnt, inv_incomplete, raw_uc, impMethod, strategy);
         CARStats.count_whole_begin();
         chk->check();
         CARStats.count_whole_end();
@@ -312,13 +636,17 @@ void check_aiger(int argc, char **argv)
     }
     
 
+    if (coi)
+        coi->lift_witness(coi_witness, res_file);
+
     // cleaning work
-    aiger_reset(aig);
+    delete coi;
+    if (aig)
+        aiger_reset(aig);
     delete model;
     res_file.close();
-#ifdef TRAIL
-    trail_file.close();
-#endif
+    if (trail_file.is_open())
+        trail_file.close();
     if (enable_draw)
         dot_file.close();
     if (enable_dive)
@@ -329,8 +657,13 @@ void check_aiger(int argc, char **argv)
 
 int main(int argc, char **argv)
 {
-    signal(SIGINT, signal_handler);
-    signal(SIGTERM, signal_handler);
+    sigset_t signals;
+    sigemptyset(&signals);
+    sigaddset(&signals, SIGINT);
+    sigaddset(&signals, SIGTERM);
+    // before any other thread starts, so that they all keep the signals blocked.
+    pthread_sigmask(SIG_BLOCK, &signals, nullptr);
+    std::thread(signal_waiter, signals).detach();
 
     check_aiger(argc, argv);
 
@@ -0,0 +1,13 @@
+// the backend over src/sat/glucose.
+#include "core/Solver.h"
+using namespace Glucose;
+#define SAT_ADAPTER_INCREMENTAL
+#include "satbackend_adapter.h"
+
+namespace car
+{
+	SatBackend *new_glucose_backend ()
+	{
+		return new Adapter ();
+	}
+}
@@ -0,0 +1,13 @@
+// the backend over src/sat/glucose-4.2.1. Its namespace is renamed to Glucose4 when building, so that it links next to src/sat/glucose.
+#include "core/Solver.h"
+using namespace Glucose;
+#define SAT_ADAPTER_INCREMENTAL
+#include "satbackend_adapter.h"
+
+namespace car
+{
+	SatBackend *new_glucose4_backend ()
+	{
+		return new Adapter ();
+	}
+}
@@ -0,0 +1,12 @@
+// the backend over src/sat/minisat.
+#include "core/Solver.h"
+using namespace Minisat;
+#include "satbackend_adapter.h"
+
+namespace car
+{
+	SatBackend *new_minisat_backend ()
+	{
+		return new Adapter ();
+	}
+}
@@ -1,50 +1,15 @@
 #include "carsolver.h"
+#include "model.h"
 #include <iostream>
 #include <vector>
 #include <algorithm>
+#include <assert.h>
 using namespace std;
-#ifdef MINISAT
-	using namespace Minisat;
-#else
-	using namespace Glucose;
-#endif // DEBUG
 
 namespace car
 {
- 	
-	/**
-	 * @brief int -> SAT lit
-	 * 
-	 * @param id 
-	 * @return Lit 
-	 */
- 	Lit CARSolver::SAT_lit (int id) 
- 	{
- 		assert (id != 0);
-        int var = abs(id)-1;
-        int varsNeeded = var - nVars() + 1; // how many needed
-        while (varsNeeded > 0) {
-            newVar();
-            --varsNeeded;
-        }
-		return ( (id > 0) ? mkLit(var) : ~mkLit(var) );
- 	}
- 	
-	/**
-	 * @brief SAT lit -> int
-	 * 
-	 * @param l 
-	 * @return int 
-	 */
- 	int CARSolver::lit_id (Lit l) const
-	{
-		if (sign(l)) 
-            return -(var(l) + 1);
-		else 
-            return var(l) + 1;
-	}
- 	
-	
+	SatBackendKind CARSolver::role_backend_[ROLE_NUM] = {default_backend (), default_backend (), default_backend (), default_backend (), default_backend ()};
+
 	/**
 	 * @brief get the assumption in _assumption
 	 * 
@@ -52,13 +17,7 @@ namespace car
 	 */
 	std::vector<int> CARSolver::get_assumption() const
 	{
-		std::vector<int> res;
-		res.reserve(assumptions.size());
-		for(int i = 0 ; i < assumptions.size();++i)
-		{
-			res.push_back(lit_id(assumptions[i]));
-		}
-		return std::move(res);
+		return assumptions;
 	}
 
 	/**
@@ -70,15 +29,8 @@ namespace car
 	std::vector<int> CARSolver::get_model () const
 	{
 		std::vector<int> res;
-		res.resize (nVars (), 0);
-   		for (int i = 0; i < nVars (); i ++)
-   		{
-     		if (model[i] == l_True)
-       			res[i] = i+1;
-     		else
-       			res[i] = -(i+1);
-   		}
-   		return std::move(res);
+		backend_->get_model (res);
+   		return res;
 	}
 
 	/**
@@ -90,14 +42,10 @@ namespace car
  	std::vector<int> CARSolver::get_uc () const
  	{
  		std::vector<int> reason;
-		reason.resize(conflict.size(),0);
-		// 
- 		for (int k = 0; k < conflict.size(); k++) 
- 		{
-        	Lit l = conflict[k];
-        	reason[k] = -lit_id (l);
-    	}
-    	return std::move(reason);
+		backend_->get_conflict (reason);
+ 		for (int k = 0; k < reason.size(); k++) 
+        	reason[k] = -reason[k];
+    	return reason;
   	}
 		
 	/**
@@ -107,15 +55,15 @@ namespace car
 	 */
 	std::vector<int> CARSolver::get_uc_no_bad (int bad) const
  	{
- 		std::vector<int> reason;
+ 		std::vector<int> conflict, reason;
+		backend_->get_conflict (conflict);
  		for (int k = 0; k < conflict.size(); k++) 
  		{
-        	Lit l = conflict[k];
-			int id = -lit_id (l);
+			int id = -conflict[k];
 			if(id!=bad)
 	        	reason.push_back (id);
     	}
-    	return std::move(reason);
+    	return reason;
   	}
 
     /**
@@ -132,28 +80,28 @@ namespace car
          */
 
         // <flag>. This is the flag of the target frame. It's easy.
-        Lit flag = assumptions[0];
+        int flag = assumptions[0];
         int sz = assumptions.size();
 
         // cerr<<"old assumptions";
         // for(int i = 0; i< sz; ++i)
-        //     cerr<<assumptions[i].x<<", ";
+        //     cerr<<assumptions[i]<<", ";
         // cerr<<endl;
 
         for(int i = 1; i <= sz/2; ++i)
         {
             // swap!
-            int tmp = assumptions[i].x;
-            assumptions[i].x = assumptions[sz-i].x;
-            assumptions[sz-i].x = tmp;
+            int tmp = assumptions[i];
+            assumptions[i] = assumptions[sz-i];
+            assumptions[sz-i] = tmp;
             
         }
         
         // cerr<<"new assumptions";
         // for(int i = 0; i< sz; ++i)
-        //     cerr<<assumptions[i].x<<", ";
+        //     cerr<<assumptions[i]<<", ";
         // cerr<<endl;
-        solve_();
+        solve_assumption();
 
         return get_uc();
         
@@ -215,14 +163,48 @@ namespace car
 	 */
 	void CARSolver::add_clause_internal (const std::vector<int>& v)
  	{
- 		vec<Lit> lits(v.size());
-		int index = 0;
-		for (int id : v)
-			lits[index++] = SAT_lit(id);
- 		bool res = addClause (lits);
+ 		add_clause_internal (v.data (), v.size ());
+ 	}
+
+	void CARSolver::add_clause_internal (const int *lits_in, const int sz)
+ 	{
+		for (std::vector<int> *journal : journals_)
+		{
+			journal->push_back (sz);
+			journal->insert (journal->end (), lits_in, lits_in + sz);
+		}
+ 		bool res = backend_->add_clause (lits_in, sz);
 		assert(res && "Warning: Adding clause does not success\n");
  	}
 
+	std::map<std::tuple<const Model *, int, SatBackendKind>, SatBackend *> CARSolver::templates_;
+
+	/**
+	 * @brief load the clauses [0, end) of the model.
+	 * The first solver of each range and backend becomes the template: it loads the clauses one by one, and is simplified at the top level.
+	 * Later solvers are clones of it, see SatBackend::copy().
+	 * 
+	 * @param m 
+	 * @param end 
+	 */
+	void CARSolver::load_model (const Model *m, const int end)
+	{
+		assert (backend_->num_vars () == 0);
+		SatBackend *&tmpl = templates_[std::make_tuple (m, end, kind_)];
+		if (tmpl == nullptr)
+		{
+			tmpl = new_backend (kind_);
+			for (int i = 0; i < end; ++i)
+			{
+				ClauseView cl = m->element (i);
+				tmpl->add_clause (cl.lits, cl.sz);
+			}
+			tmpl->simplify_db ();
+		}
+		delete backend_;
+		backend_ = tmpl->copy ();
+	}
+
 	/**
 	 * @brief helper function, print last 3 clauses in the Solver.
 	 * 
@@ -230,15 +212,14 @@ namespace car
 	void CARSolver::print_last_3_clauses()
 	{
 		cout << "Last 3 clauses in SAT solver: \n";
+		std::vector<std::vector<int>> clauses;
+		backend_->get_clauses (clauses);
 		int cnt = 0;
 		for (int i = clauses.size () -1 ; i >=0; i--)
 		{
 			if(++cnt == 4)
 				break;
-			Clause& c = ca[clauses[i]];
-			std::vector<int> vec;
-			for (int j = 0; j < c.size (); j ++)
-				vec.push_back(lit_id(c[j]));
+			std::vector<int> vec = clauses[i];
 			std::sort(vec.begin(),vec.end(),[](int a, int b){return abs(a) < abs(b);});
 			for (int j = 0; j < vec.size (); j ++)
 				cout<<vec[j]<<" ";
@@ -254,11 +235,12 @@ namespace car
  	void CARSolver::print_clauses(ostream & out)
 	{
 		out << "clauses in SAT solver: \n";
+		std::vector<std::vector<int>> clauses;
+		backend_->get_clauses (clauses);
 		for (int i = 0; i < clauses.size (); i ++)
 		{
-			Clause& c = ca[clauses[i]];
-			for (int j = 0; j < c.size (); j ++)
-				out << lit_id (c[j]) << " ";
+			for (int j = 0; j < clauses[i].size (); j ++)
+				out << clauses[i][j] << " ";
 			out << "0 " << endl;
 		}
 	}
@@ -273,7 +255,7 @@ namespace car
 		if (!assumptions.size())
 			out<<" Empty ";
 	    for (int i = 0; i < assumptions.size (); i ++)
-	        out << lit_id (assumptions[i]) << " ";
+	        out << assumptions[i] << " ";
 	    out << endl;
 	}
 	
@@ -3,43 +3,42 @@
 #define	CAR_SOLVER_H
 
 #include "statistics.h"
+#include "basic_data.h"
+#include "satbackend.h"
 #include <iostream>
-
-#ifdef MINISAT
-	#include "Solver.h"
-	namespace CARSolverNS {
-		using SolverType = Minisat::Solver;
-	}
-#else
-	#include "Solver.h"
-	namespace CARSolverNS {
-		using SolverType = Glucose::Solver;
-	}
-#endif // MINISAT
 #include <vector>
+#include <algorithm>
+#include <map>
+#include <tuple>
 
 namespace car
 {
 		extern Statistics CARStats;
-		class CARSolver : public CARSolverNS::SolverType
+		class Model;
+		/**
+		 * @brief The SAT solver of each role. The solving itself is done by a SatBackend, picked by the role at runtime.
+		 */
+		class CARSolver
 		{
 		public:
-			CARSolver() {}
+			CARSolver(const SolverRole role) : backend_(new_backend(role_backend_[role])), kind_(role_backend_[role]) {}
+			virtual ~CARSolver() { delete backend_; }
+			CARSolver(const CARSolver &) = delete;
+			CARSolver &operator=(const CARSolver &) = delete;
+
+			// the backend of each role. Set them before any solver is created.
+			static inline void set_backend(const SolverRole role, const SatBackendKind kind) { role_backend_[role] = kind; }
 
-#ifdef MINISAT
-			Minisat::Lit SAT_lit(int id);	// create the Lit used in SAT solver for the id.
-			int lit_id(Minisat::Lit) const; // return the id of SAT lit
-#else
-			Glucose::Lit SAT_lit(int id);			// create the Lit used in SAT solver for the id.
-			int lit_id(Glucose::Lit) const;			// return the id of SAT lit
-#endif // MINISAT
             /**
              * @brief Solve with the assumptions in _assumption. 
              * @note before this, make sure all the assumption lits are put into assumptions.
              */
-			inline bool solve_assumption() { auto res = solve_(); return res == l_True; }								// Solve with the assumptions in _assumption.
-			inline int size() { return clauses.size(); }			// Solve with the assumptions in _assumption.
+			inline bool solve_assumption() { return backend_->solve_assumption(assumptions); }	// Solve with the assumptions in _assumption.
+			inline bool unsat_within(const int64_t budget) { return backend_->unsat_within(assumptions, budget); } // true only if found UNSAT within the budget of propagations.
+			inline int size() { return backend_->num_clauses(); }			// number of clauses in the solver.
 			inline void clear_assumption() { assumptions.clear(); } // clear the assumptions
+			inline void load_assumption(const std::vector<int> &assumption) { assumptions = assumption; } // set the assumptions as they are
+			inline void set_incremental_mode() { backend_->set_incremental(); }
 			std::vector<int> get_assumption() const;				// get the assumption
 			std::vector<int> get_model() const;						// get the model from SAT solver
 			std::vector<int> get_uc() const;						// get UC from SAT solver
@@ -48,6 +47,7 @@ namespace car
 			void add_cube(const std::vector<int> &);				// add each element in uc as a clause
 			void add_cube_negate(const std::vector<int> &cu);	    // add the negate of the cube
 			void add_clause_internal(const std::vector<int> &);		// add the or clause
+			void add_clause_internal(const int *lits, const int sz);	// add the or clause, from a flat array
 
 			template <typename... Args>
 			void add_clause(Args... args)
@@ -55,11 +55,35 @@ namespace car
 				std::vector<int> v = {args...};
 				add_clause_internal(v);
 			}
+			// clauses of the model are views into its clause arena, no copy is needed.
+			inline void add_clause(const ClauseView &cl) { add_clause_internal(cl.lits, cl.sz); }
+
+			// log the clauses added from now on into journal as [size, lit, lit, ...], for the clones of this solver to replay. A solver may have several journals.
+			inline void add_journal(std::vector<int> *journal) { journals_.push_back(journal); }
+			inline void remove_journal(std::vector<int> *journal) { journals_.erase(std::remove(journals_.begin(), journals_.end(), journal), journals_.end()); }
+
+			// load the clauses [0, end) of the model. They are copied from a template solver, which is built once for each range and backend.
+			void load_model(const Model *m, const int end);
 
 			// printers
 			void print_last_3_clauses();
 			void print_clauses(std::ostream & out_stream);
 			void print_assumption(std::ostream & out_stream);
+
+		protected:
+			std::vector<int> assumptions;
+			SatBackend *backend_;
+
+			// the value of var in the last model: var, -var, or 0 if it is unassigned.
+			inline int model_value(const int var) const { return backend_->model_value(var); }
+			inline void simplify() { backend_->simplify_db(); }
+
+		private:
+			SatBackendKind kind_;
+			std::vector<std::vector<int> *> journals_;
+			static SatBackendKind role_backend_[ROLE_NUM];
+			// template solvers of the model, keyed by the end of the loaded range, and the backend.
+			static std::map<std::tuple<const Model *, int, SatBackendKind>, SatBackend *> templates_;
 		};
 }
 
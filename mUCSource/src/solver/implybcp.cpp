@@ -0,0 +1,121 @@
+#include "implybcp.h"
+#include <stdlib.h>
+#include <utility>
+
+namespace car
+{
+    void ImplyBCP::grow(int lit)
+    {
+        int var = abs(lit);
+        if (var >= val_.size())
+        {
+            val_.resize(var + 1, 0);
+            watches_.resize(2 * var + 2);
+        }
+    }
+
+    void ImplyBCP::add_uc(const UC &uc)
+    {
+        ++num_clauses_;
+        if (uc.empty())
+        {
+            empty_.push_back(uc);
+            return;
+        }
+        if (uc.size() == 1)
+        {
+            grow(uc[0]);
+            units_.push_back(uc);
+            return;
+        }
+        for (int lit : uc)
+            grow(lit);
+        uint32_t cref = clauses_.size();
+        clauses_.push_back({uc, 0, 1});
+        watches_[code(-uc[0])].push_back(cref);
+        watches_[code(-uc[1])].push_back(cref);
+    }
+
+    bool ImplyBCP::assign(int lit)
+    {
+        int v = value(lit);
+        if (v != 0)
+            return v > 0;
+        grow(lit);
+        val_[abs(lit)] = lit > 0 ? 1 : -1;
+        trail_.push_back(lit);
+        return true;
+    }
+
+    int64_t ImplyBCP::propagate()
+    {
+        for (int qhead = 0; qhead < trail_.size(); ++qhead)
+        {
+            int false_lit = -trail_[qhead];
+            std::vector<uint32_t> &ws = watches_[code(false_lit)];
+            size_t i = 0, j = 0;
+            for (; i < ws.size(); ++i)
+            {
+                uint32_t cref = ws[i];
+                Clause &c = clauses_[cref];
+                const UC &uc = c.uc;
+                // the false literal goes to w1. The literals of the clause are the negations of the UC.
+                if (-uc[c.w0] == false_lit)
+                    std::swap(c.w0, c.w1);
+                int other = -uc[c.w0];
+                if (value(other) > 0)
+                {
+                    ws[j++] = cref;
+                    continue;
+                }
+                bool moved = false;
+                for (int k = 0; k < uc.size(); ++k)
+                {
+                    if (k != c.w0 && k != c.w1 && value(-uc[k]) >= 0)
+                    {
+                        c.w1 = k;
+                        watches_[code(-uc[k])].push_back(cref);
+                        moved = true;
+                        break;
+                    }
+                }
+                if (moved)
+                    continue;
+                ws[j++] = cref;
+                if (value(other) < 0)
+                {
+                    // keep the rest of the watches.
+                    for (++i; i < ws.size(); ++i)
+                        ws[j++] = ws[i];
+                    ws.resize(j);
+                    return cref;
+                }
+                assign(other);
+            }
+            ws.resize(j);
+        }
+        return -1;
+    }
+
+    const UC *ImplyBCP::conflicts(const std::vector<int> &assignment)
+    {
+        const UC *res = empty_.empty() ? nullptr : &empty_[0];
+        // the assignment goes first, so that a unit against it is the clause blamed.
+        for (int lit : assignment)
+            assign(lit);
+        for (int i = 0; !res && i < units_.size(); ++i)
+            if (!assign(-units_[i][0]))
+                res = &units_[i];
+        if (!res)
+        {
+            int64_t cref = propagate();
+            if (cref >= 0)
+                res = &clauses_[cref].uc;
+        }
+
+        for (int lit : trail_)
+            val_[abs(lit)] = 0;
+        trail_.clear();
+        return res;
+    }
+}
@@ -0,0 +1,60 @@
+#ifndef IMPLY_BCP_H
+#define IMPLY_BCP_H
+
+#include "basic_data.h"
+#include <vector>
+#include <stdint.h>
+
+namespace car
+{
+    /**
+     * @brief Unit propagation over the clauses of the negated UCs of one level, with two watched literals and no decisions.
+     * It answers whether an assignment (a state, full or partial) propagates to a conflict, that is, whether the state is blocked by the level.
+     * The watches are not restored after a check, which is fine for two watched literals.
+     * The literals are read from the UC store, a clause only keeps the positions of its two watches.
+     */
+    class ImplyBCP
+    {
+    public:
+        // add the clause ~uc.
+        void add_uc(const UC &uc);
+        // the UC of the clause that the assignment and the clauses propagate to a conflict in, nullptr if there is no conflict. The assignment is undone afterwards.
+        const UC *conflicts(const std::vector<int> &assignment);
+        inline int size() const { return num_clauses_; }
+
+    private:
+        struct Clause
+        {
+            UC uc;
+            // positions of the watched literals in uc.
+            uint32_t w0, w1;
+        };
+        std::vector<Clause> clauses_;
+        // clauses of one literal, they are checked at the start of each call.
+        std::vector<UC> units_;
+        // the empty clause, if it was added.
+        std::vector<UC> empty_;
+        int num_clauses_ = 0;
+        // clauses watching each literal, indexed by code().
+        std::vector<std::vector<uint32_t>> watches_;
+        // value of each variable: 1, -1, or 0 if it is unassigned.
+        std::vector<int8_t> val_;
+        std::vector<int> trail_;
+
+        static inline uint32_t code(int lit) { return lit > 0 ? 2 * lit : -2 * lit + 1; }
+        inline int value(int lit) const
+        {
+            int var = lit > 0 ? lit : -lit;
+            if (var >= val_.size())
+                return 0;
+            return lit > 0 ? val_[var] : -val_[var];
+        }
+        // make lit true. Return false if it is already false.
+        bool assign(int lit);
+        // the clause of the conflict met, -1 if none.
+        int64_t propagate();
+        void grow(int lit);
+    };
+}
+
+#endif
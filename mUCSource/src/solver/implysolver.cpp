@@ -2,27 +2,33 @@
 #include <algorithm>
 using namespace std;
 
-#ifdef MINISAT
-using namespace Minisat;
-#else
-using namespace Glucose;
-#endif
-
 namespace car
 {
     std::map<int, int> counter;
     std::map<int, std::map<int, double>> moms;
     std::map<int, std::shared_ptr<ImplySolver>> ImplySolver::imp_solvers;
+    bool ImplySolver::use_bcp = true;
+    std::map<int, ImplyBCP> ImplySolver::bcps;
 
     bool ImplySolver::is_blocked_MOM(State *s, int level)
     {
-        // not so good to those with large latches scales.
-        std::shared_ptr<ImplySolver> solver = getSolver(level);
         if(moms.find(level) == moms.end())
         {
             moms[level] = {};
             return false;
         }
+        // the order of the assumption does not matter to propagation.
+        if(use_bcp)
+        {
+            // the UC of the conflicting clause is the one that blocks the state.
+            const UC *uc = bcps[level].conflicts(s->s());
+            if(uc)
+                uc->bump();
+            return uc != nullptr;
+        }
+
+        // not so good to those with large latches scales.
+        std::shared_ptr<ImplySolver> solver = getSolver(level);
 
         auto& ref = moms[level];
         std::vector<int> ass = s->s();
@@ -34,26 +40,29 @@ namespace car
            we do not actually need the solution. We just want to check whether it is blocked by any UC.
            if blocked, it's clear, that to propagate the state will already make the assignment of the UC's clause to be UNSAT.
         */
-        solver->Solver::setPropBudget(s->num_latches_);
-        return solver->Solver::solve_()==l_False;
+        return solver->backend_->unsat_within(solver->assumptions, s->num_latches_);
     };
 
-    void ImplySolver::add_uc_MOM(const std::vector<int> &uc, int level)
+    void ImplySolver::add_uc_MOM(const UC &uc, int level)
     {
-        std::shared_ptr<ImplySolver> solver = getSolver(level);
         if(moms.find(level) == moms.end())
         {
             moms[level] = {};
         }
         // add negate of uc as a clause.
         // no flag. forever added.
-        vec<Lit> lits(uc.size());
-        int index = 0;
-        for (int id : uc)
+        if(use_bcp)
+            bcps[level].add_uc(uc);
+        else
         {
-            lits[index++] = solver->SAT_lit(-id);
+            std::vector<int> lits(uc.size());
+            int index = 0;
+            for (int id : uc)
+            {
+                lits[index++] = -id;
+            }
+            getSolver(level)->backend_->add_clause(lits.data(), lits.size());
         }
-        solver->addClause(lits);
         if(uc.size() <= 10)
         {
             ++counter[level];
@@ -69,6 +78,15 @@ namespace car
 
     bool ImplySolver::is_blocked(State *s, int level)
     {
+        if(use_bcp)
+        {
+            // the UC of the conflicting clause is the one that blocks the state.
+            const UC *uc = bcps[level].conflicts(s->s());
+            if(uc)
+                uc->bump();
+            return uc != nullptr;
+        }
+
         // not so good to those with large latches scales.
         std::shared_ptr<ImplySolver> solver = getSolver(level);
         solver->set_assumption(s->s());
@@ -77,19 +95,31 @@ namespace car
            we do not actually need the solution. We just want to check whether it is blocked by any UC.
            if blocked, it's clear, that to propagate the state will already make the assignment of the UC's clause to be UNSAT.
         */
-        solver->Solver::setPropBudget(s->num_latches_);
-        return solver->Solver::solve_()==l_False;
+        return solver->backend_->unsat_within(solver->assumptions, s->num_latches_);
     };
 
-    void ImplySolver::add_uc(const std::vector<int> &uc, int level)
+    void ImplySolver::reset_level(int level)
     {
-        std::shared_ptr<ImplySolver> solver = getSolver(level);
+        imp_solvers.erase(level);
+        bcps.erase(level);
+        moms.erase(level);
+        counter.erase(level);
+    }
+
+    void ImplySolver::add_uc(const UC &uc, int level)
+    {
+        // the engine shares the copy of the UC store.
+        if(use_bcp)
+        {
+            bcps[level].add_uc(uc);
+            return;
+        }
         // add negate of uc as a clause.
         // no flag. forever added.
-        vec<Lit> lits(uc.size());
+        std::vector<int> lits(uc.size());
         int index = 0;
         for (int id : uc)
-            lits[index++] = solver->SAT_lit(-id);
-        solver->addClause(lits);
+            lits[index++] = -id;
+        getSolver(level)->backend_->add_clause(lits.data(), lits.size());
     }
 } // namespace car
\ No newline at end of file
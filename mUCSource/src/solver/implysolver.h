@@ -2,6 +2,7 @@
 #define ImplySolver_H
 
 #include "carsolver.h"
+#include "implybcp.h"
 #include "data_structure.h"
 #include "statistics.h"
 #include <map>
@@ -14,7 +15,7 @@ namespace car
     class ImplySolver : public CARSolver
     {
     public:
-        ImplySolver(int lvl) : level(lvl){};
+        ImplySolver(int lvl) : CARSolver(ROLE_IMPLY), level(lvl){};
         ~ImplySolver(){};
 
         static std::shared_ptr<ImplySolver> getSolver(int lvl)
@@ -27,26 +28,34 @@ namespace car
             return imp_solvers[lvl];
         }
 
+        // check blocking by unit propagation only (ImplyBCP), instead of a budgeted SAT call. Set it before any UC is added.
+        static inline void set_bcp(bool on) { use_bcp = on; }
+
         static bool is_blocked(State *s, int level);
 
-        static void add_uc(const std::vector<int> &uc, int level);
+        static void add_uc(const UC &uc, int level);
 
         static bool is_blocked_MOM(State *s, int level);
 
-        static void add_uc_MOM(const std::vector<int> &uc, int level);
+        static void add_uc_MOM(const UC &uc, int level);
 
         static inline void print_sz() {
             std::cerr<<"start printing sz"<<std::endl;
-            for(auto& pr: imp_solvers) { std::cerr<<pr.first<<" : "<<pr.second->nClauses() <<std::endl; } 
+            for(auto& pr: imp_solvers) { std::cerr<<pr.first<<" : "<<pr.second->size() <<std::endl; } 
+            for(auto& pr: bcps) { std::cerr<<pr.first<<" : "<<pr.second.size() <<std::endl; } 
             std::cerr<<"end printing sz"<<std::endl;
         }
 
+        // forget the UCs of the level, to add the kept ones again.
+        static void reset_level(int level);
+
         static void reset_all()
         {
             for(auto& pr: imp_solvers) { 
                 pr.second = nullptr;
             }
             imp_solvers.clear();
+            bcps.clear();
         }
 
     private:
@@ -56,13 +65,15 @@ namespace car
             assumptions.clear();
             for (const int &var : state)
             {
-                assumptions.push(SAT_lit(var));
+                assumptions.push_back(var);
             }
         }
         // which level it is for.
         int level;
         // Static map to store solvers for each level
         static std::map<int, std::shared_ptr<ImplySolver>> imp_solvers;
+        static bool use_bcp;
+        static std::map<int, ImplyBCP> bcps;
     };
 
 } // namespace car
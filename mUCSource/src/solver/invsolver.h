@@ -14,12 +14,10 @@ namespace car
 	{
 		bool verbose_;
 		public:
-			InvSolver (const Model* m, bool verbose=false) : verbose_(verbose),id_aiger_max_ (const_cast<Model*>(m)->max_id ())
+			InvSolver (const Model* m, bool verbose=false) : CARSolver (ROLE_INV), verbose_(verbose),id_aiger_max_ (const_cast<Model*>(m)->max_id ())
 			{
 				model_ = const_cast<Model*> (m);
-			    int end =  model_->outputs_start ();
-			    for (int i = 0; i < end ; i ++)
-                    add_clause (model_->element (i));
+			    load_model (model_, model_->outputs_start ());
 			}
 			~InvSolver () {}
 		
@@ -123,29 +121,18 @@ namespace car
 
 			/**
 			 * @brief Add this uc to target level.
-			 * 1. turn off old or_flag.
-			 * 2. add new uc clause, create new or_flag, turn it on.
+			 * 1. turn off old or_flag, for good.
+			 * 2. add new uc clause, create new or_flag, turn it on in the place of the old one.
 			 * 
 			 */
 			inline void add_uc_or(const Cube &uc, int level){
-				// prior assumption
-				std::vector<int> old_flags = get_assumption();
-				
 				// invalidate old frame flag.
 				int old_flag = or_flag[level];
 				assert(old_flag!=0);
-				for(int i = 0; i < old_flags.size(); ++i)
-				{
-					if(old_flags[i] == old_flag)
-					{
-						// negate it
-						old_flags[i] = -old_flag;
-						#ifdef PRINT_INV
-						std::cout<<"[flag] block old or-frame flag: "<<-or_flag[level]<<std::endl;
-						#endif
-						break;
-					}
-				}
+				add_clause (-old_flag);
+				#ifdef PRINT_INV
+				std::cout<<"[flag] block old or-frame flag: "<<-or_flag[level]<<std::endl;
+				#endif
 				
 				// generate a new frame flag
 				or_flag[level] = new_var();
@@ -168,8 +155,7 @@ namespace car
 				#ifdef PRINT_INV
 				std::cout<<"[flag] new flag for or-frame: "<<or_flag[level]<<std::endl;
 				#endif
-				old_flags.push_back(or_flag[level]);
-				set_assumptions(old_flags);				
+				replace_assumption(old_flag, or_flag[level]);
 			}
 			
 			/**
@@ -179,7 +165,7 @@ namespace car
 			 */
 			inline void update_assumption_for_constraint (const int frame_flag)
 			{
-				assumptions.push (SAT_lit (frame_flag));
+				assumptions.push_back (frame_flag);
 			}
 			
 			inline void set_assumptions(const std::vector<int>& assumes)
@@ -187,28 +173,17 @@ namespace car
 				assumptions.clear();
 				for(auto &lit:assumes)
 				{
-					assumptions.push(SAT_lit(lit));
+					assumptions.push_back(lit);
 				}
 			}
 			
 			/**
-			 * @brief pop the last lit of assumption, and negate it.
+			 * @brief drop the and_flag from the assumption, and fix it to false.
 			 * 
 			 */
 			inline void release_constraint_and (int level)
 			{
-				// invalidate old and_flag
-				std::vector<int> old_assumptions = get_assumption();
-				for(int i = 0; i < old_assumptions.size();++i)
-				{
-					if(old_assumptions[i] == and_flag[level])
-					{
-						old_assumptions[i] = -and_flag[level];
-						break;
-					}
-				}
-				set_assumptions(old_assumptions);
-				
+				replace_assumption(and_flag[level], 0);
 				add_clause(-and_flag[level]);
 				simplify();
 			}
@@ -289,6 +264,24 @@ namespace car
 
 			std::vector<int> frame_flags;	
 
+			/**
+			 * @brief replace the lit in the assumption by another one, or drop it if `by` is 0.
+			 * @note The assumption has at most one flag for each level, and the latest ones are at the back, so this does not grow with the rounds.
+			 */
+			inline void replace_assumption(int lit, int by)
+			{
+				for (int i = assumptions.size() - 1; i >= 0; --i)
+				{
+					if (assumptions[i] != lit)
+						continue;
+					if (by != 0)
+						assumptions[i] = by;
+					else
+						assumptions.erase(assumptions.begin() + i);
+					return;
+				}
+			}
+
 		protected:
 			Model* model_;
 			int id_aiger_max_;  	//to store the maximum number used in aiger model
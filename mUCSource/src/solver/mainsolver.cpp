@@ -15,33 +15,18 @@ namespace car
 	 * @param m 
 	 * @param verbose 
 	 */
-	MainSolver::MainSolver (Model* m,int rotate_is_on, const bool verbose, bool uc_no_sort) : rotate_is_on(rotate_is_on), uc_no_sort(uc_no_sort)
+	MainSolver::MainSolver (Model* m,int rotate_is_on, const bool verbose, bool uc_no_sort) : CARSolver (ROLE_MAIN), rotate_is_on(rotate_is_on), uc_no_sort(uc_no_sort)
 	{
 		model_ = m;
 		max_flag = m->max_id() + 1;
 		unroll_level = 1;
 		// BASIC STEP:
 		// (1) create clauses for constraints encoding
-		for (int i = 0; i < m->common_next_start(); ++i)
-		{
-			add_clause (m->element (i));
-		}
 		// (2) same next have same previous, initialized to 0.
-		for( int i = m->common_next_start(); i< m->outputs_start(); ++i)
-		{
-			add_clause(m->element(i));
-		}
 		// (3) clause for encoding outputs.
-		for (int i = m->outputs_start (); i < m->latches_start (); ++i)
-		{
-			add_clause (m->element (i));
-		}
 		// (4) clause for encoding latches's mapping relation
 		// (5) create clauses for true and false
-		for (int i = m->latches_start (); i < m->size (); ++i)
-		{
-			add_clause (m->element (i));
-		}
+		load_model (m, m->size ());
 	}
 
 	/**
@@ -73,7 +58,7 @@ namespace car
 	 * @param verbose 
 	 * @param unroll_level 
 	 */
-	MainSolver::MainSolver (Model* m, const bool verbose, int unroll_level, bool __placeholder) 
+	MainSolver::MainSolver (Model* m, const bool verbose, int unroll_level, bool __placeholder) : CARSolver (ROLE_MAIN)
 	{
 		assert(unroll_level >=1);
 		// no need to unroll if level == 1.
@@ -86,26 +71,11 @@ namespace car
 			
 		// BASIC STEP:
 		// (1) create clauses for constraints encoding
-		for (int i = 0; i < m->common_next_start(); ++i)
-		{
-			add_clause (m->element (i));
-		}
 		// (2) same next have same previous, initialized to 0.
-		for( int i = m->common_next_start(); i< m->outputs_start(); ++i)
-		{
-			add_clause(m->element(i));
-		}
 		// (3) clause for encoding outputs.
-		for (int i = m->outputs_start (); i < m->latches_start (); ++i)
-		{
-			add_clause (m->element (i));
-		}
 		// (4) clause for encoding latches's mapping relation
 		// (5) create clauses for true and false
-		for (int i = m->latches_start (); i < m->size (); ++i)
-		{
-			add_clause (m->element (i));
-		}
+		load_model (m, m->size ());
 
 		// flag for the first level
 		int flag_for_first_level = 1 * lits_each_round;
@@ -133,10 +103,10 @@ namespace car
 	void MainSolver::set_assumption (const Assignment& assum, const int bad_id)
 	{
         assumptions.clear ();
-		assumptions.push (SAT_lit (bad_id));
+		assumptions.push_back (bad_id);
 		for (const int &var :assum)
 		{
-			assumptions.push (SAT_lit (var));
+			assumptions.push_back (var);
 		}
 	}
 
@@ -151,11 +121,11 @@ namespace car
     {
         assumptions.clear();
         if (frame_level > -1)
-			assumptions.push (SAT_lit (flag_of(O,frame_level)));
+			assumptions.push_back (flag_of(O,frame_level));
 		for (const int &id :s->s())
 		{
 			int target = forward ? model_->prime (id) : id;
-			assumptions.push (SAT_lit (target));
+			assumptions.push_back (target);
 		}
     }
 
@@ -163,7 +133,7 @@ namespace car
     {
         assumptions.clear();
         if (frame_level > -1)
-			assumptions.push (SAT_lit (flag_of(O,frame_level)));
+			assumptions.push_back (flag_of(O,frame_level));
         for(int i = 0; i < prefers.size(); ++i)
 		{
 			auto &vec = prefers[i];
@@ -171,7 +141,7 @@ namespace car
 			for(auto &id : vec)
 			{
 				int target = forward?model_->prime(id) : id;
-				assumptions.push(SAT_lit(target));
+				assumptions.push_back(target);
 			}
 		}
         if(!rotate_is_on)
@@ -181,12 +151,54 @@ namespace car
             for (const int &id :s->s())
             {
                 int target = forward ? model_->prime (id) : id;
-                assumptions.push (SAT_lit (target));
+                assumptions.push_back (target);
             }
         }
     }
 
 
+	void MainSolver::set_assumption(Osequence *O, const Cube &cu, const int frame_level, const bool forward)
+	{
+		assumptions.clear();
+		if (frame_level > -1)
+			assumptions.push_back (flag_of(O,frame_level));
+		for (const int &id : cu)
+			assumptions.push_back (forward ? model_->prime (id) : id);
+	}
+
+	int MainSolver::shrink_uc(const int flag, Cube &uc, const bool forward, const int attempts, const int64_t budget)
+	{
+		// the UC may have its last literal twice, see set_uc_order().
+		auto distinct = [](const Cube &cu)
+		{
+			Cube res = cu;
+			std::sort(res.begin(), res.end(), car::comp);
+			res.erase(std::unique(res.begin(), res.end()), res.end());
+			return res;
+		};
+		Cube lits = distinct(uc);
+		int tries = 0;
+		for (int i = 0; i < lits.size() && lits.size() > 1 && tries < attempts; ++tries)
+		{
+			assumptions.clear();
+			assumptions.push_back(flag);
+			for (int j = 0; j < lits.size(); ++j)
+				if (j != i)
+					assumptions.push_back(forward ? model_->prime(lits[j]) : lits[j]);
+			if (unsat_within(budget))
+			{
+				Cube core = get_conflict(forward);
+				if (core.empty())
+					break;
+				uc = core;
+				lits = distinct(core);
+			}
+			else
+				++i;
+		}
+		return tries;
+	}
+
 	bool MainSolver::solve_with_assumption (const Assignment& st, const int p)
 	{
 		set_assumption(st,p);
@@ -212,6 +224,85 @@ namespace car
 		return s;
 	}
 
+	void MainSolver::get_more_states(std::vector<State*>& states, State *first, const int more, const bool forward)
+	{
+		int flag = max_flag++;
+		assumptions.push_back(flag);
+		State *last = first;
+		for (int i = 0; i < more; ++i)
+		{
+			// the latches of the state found are next ones in backward search.
+			std::vector<int> cl = {-flag};
+			for (int lit : last->s())
+				cl.push_back(forward ? -lit : -model_->prime(lit));
+			add_clause(cl);
+			if (!solve_assumption())
+				break;
+			last = get_state(forward);
+			states.push_back(last);
+		}
+		assumptions.pop_back();
+		add_clause(-flag);
+		simplify();
+	}
+
+	int MainSolver::solve_batch(Osequence *O, const std::vector<State *> &states, const int frame_level, const bool forward, State *&next, Cube &uc)
+	{
+		Cube common = states[0]->s();
+		for (int i = 1; i < states.size(); ++i)
+			common = states[i]->intersect(common);
+
+		int act = max_flag++;
+		std::vector<int> selectors;
+		std::vector<int> any = {-act};
+		for (State *s : states)
+		{
+			int sel = max_flag++;
+			selectors.push_back(sel);
+			any.push_back(sel);
+			// common is in the order of the state.
+			int j = 0;
+			for (int lit : s->s())
+			{
+				if (j < common.size() && common[j] == lit)
+				{
+					++j;
+					continue;
+				}
+				add_clause(-sel, forward ? model_->prime(lit) : lit);
+			}
+		}
+		add_clause(any);
+
+		assumptions.clear();
+		assumptions.push_back(flag_of(O, frame_level));
+		assumptions.push_back(act);
+		for (int lit : common)
+			assumptions.push_back(forward ? model_->prime(lit) : lit);
+
+		int res = -1;
+		uc.clear();
+		if (solve_assumption())
+		{
+			for (int i = 0; i < selectors.size() && res < 0; ++i)
+				if (model_value(selectors[i]) > 0)
+					res = i;
+			next = get_state(forward);
+		}
+		else
+		{
+			Cube core = get_uc();
+			if (std::find(core.begin(), core.end(), act) == core.end())
+				uc = get_conflict(forward);
+		}
+
+		add_clause(-act);
+		for (int sel : selectors)
+			add_clause(-sel);
+		simplify();
+		return res;
+	}
+
 	// the states in ret is not owned by MainSolver
 	void MainSolver::get_states(std::vector<State*>& ret, const bool forward)
 	{
@@ -258,16 +349,13 @@ namespace car
 		Cube res = get_uc_no_bad (bad);
 		if(res.empty())
 			return res;
-        #ifdef LAST_FIRST
 		int last_lit = res.back();
-        #endif // LAST_FIRST
         if(!uc_no_sort)
         {
     		sort(res.begin(),res.end(),car::comp);
         }
-        #ifdef LAST_FIRST
-		res.push_back(last_lit);
-        #endif // LAST_FIRST
+        if(last_first_)
+		    res.push_back(last_lit);
 		return std::move(res);
 	}
 	
@@ -289,19 +377,14 @@ namespace car
 		{
 		    model_->shrink_to_latch_vars (conflict);
 		}
-		#ifdef FRONT_FLAG
-		int conflict_back = conflict.front();
-		#else
-		int conflict_back = conflict.back();
-		#endif
+		int conflict_back = front_flag_ ? conflict.front() : conflict.back();
 
         if(!uc_no_sort)
         {
             std::sort (conflict.begin (), conflict.end (), car::comp);
         }
-        #ifdef LAST_FIRST
-		conflict.push_back(conflict_back);
-        #endif
+        if(last_first_)
+		    conflict.push_back(conflict_back);
 		return std::move(conflict);
 	}
 
@@ -317,18 +400,13 @@ namespace car
 		{
 		    model_->shrink_to_latch_vars (conflict);
 		}
-		#ifdef FRONT_FLAG
-		int conflict_back = conflict.front();
-		#else
-		int conflict_back = conflict.back();
-		#endif
+		int conflict_back = front_flag_ ? conflict.front() : conflict.back();
 
         #ifndef UC_NO_SORT
 		std::sort (conflict.begin (), conflict.end (), car::comp);
         #endif
-        #ifdef LAST_FIRST
-		conflict.push_back(conflict_back);
-        #endif
+        if(last_first_)
+		    conflict.push_back(conflict_back);
 		return std::move(conflict);
 	}
 	
@@ -340,6 +418,14 @@ namespace car
 		}
 	}
 
+	void MainSolver::retire_frame(Osequence *O, const int frame_level)
+	{
+		int old_flag = flag_of(O, frame_level);
+		add_clause(-old_flag);
+		flag_of_O[O][frame_level] = max_flag++;
+		simplify();
+	}
+
 	// Actually, each center_state should only exist in O sequence in one direction.
 	// Should we just record this?
 	void MainSolver::add_clause_from_cube(const Cube &cu, const int frame_level, Osequence *O, const bool forward)
@@ -393,7 +479,8 @@ namespace car
 		for (int i = 0; i < model_->size(); ++i)
 		{
 			// copy it first
-			vector<int> unrolled_clause = model_->element(i);
+			ClauseView view = model_->element(i);
+			vector<int> unrolled_clause (view.begin(), view.end());
 			
 			// unroll it
 			for(int &lit : unrolled_clause)
@@ -426,7 +513,7 @@ namespace car
 		for(int i = 2; i <= level; ++i)
 		{
 			int flag_for_this_level = i * lits_per_round();
-			assumptions.push (SAT_lit (flag_for_this_level));
+			assumptions.push_back (flag_for_this_level);
 		}
 	}
 
@@ -436,7 +523,7 @@ namespace car
 		for(int i = 1; i <= unroll_level; ++i)
 		{
 			int flag_for_this_level = i * lits_per_round();
-			assumptions.push (SAT_lit (flag_for_this_level));
+			assumptions.push_back (flag_for_this_level);
 		}
 	}
 	
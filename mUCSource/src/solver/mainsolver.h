@@ -25,6 +25,8 @@ namespace car
 		// set assumption = { s->s() , flag_of(Os[frame_level]) }
 		void set_assumption(Osequence *O, State *s, const int frame_level, const bool forward);
 		void set_assumption(Osequence *O, State *s, const int frame_level, const bool forward, const std::vector<Cube>& prefers);
+		// set assumption = { flag_of(Os[frame_level]), cu }
+		void set_assumption(Osequence *O, const Cube &cu, const int frame_level, const bool forward);
 		
         // if assumptions are already set, just solve.
 		inline bool solve_with_assumption(){return CARSolver::solve_assumption();};
@@ -34,8 +36,32 @@ namespace car
 		State* get_state(const bool forward);
 
 		void get_states(std::vector<State*>& states, const bool forward);
+
+		/**
+		 * @brief after a SAT query, up to `more` other successors (predecessors in forward search) for the same assumption.
+		 * Each state found is blocked by a clause under a flag of its own, which is disabled at the end. The assumption is kept.
+		 * @note the states are not owned by MainSolver.
+		 */
+		void get_more_states(std::vector<State*>& states, State *first, const int more, const bool forward);
 		Assignment get_state_full_assignment(const bool forward);
 
+		/**
+		 * @brief drop literals from uc, a UC of a failed query with the frame flag, as long as the query stays UNSAT within the budget of propagations.
+		 * The core of each successful try replaces uc, so a try may drop more than one literal.
+		 * @return the number of tries, at most attempts.
+		 * @note it does not touch the frames, so a clone of the main solver can run it on another thread.
+		 */
+		int shrink_uc(const int flag, Cube &uc, const bool forward, const int attempts, const int64_t budget);
+
+		/**
+		 * @brief one query for full states: does any of them have a successor (predecessor in forward search) in O[frame_level]?
+		 * The literals common to all the states are assumed, the rest of each state is under a selector of its own, and one of the selectors must hold.
+		 * @return the index of a state that has one, and the state found in `next`; -1 if none has.
+		 * Then `uc` is a UC that blocks all the states, if the core does not need the selectors; empty otherwise, and each state needs its own query.
+		 * @note the selectors are disabled afterwards. The states found are not owned by MainSolver.
+		 */
+		int solve_batch(Osequence *O, const std::vector<State *> &states, const int frame_level, const bool forward, State *&next, Cube &uc);
+
 		// this version is used for bad check only
 		Cube get_conflict_no_bad(const int bad);
 		Cube get_conflict(const bool forward);
@@ -48,10 +74,16 @@ namespace car
 
 		void add_new_frame(const Frame& frame, const int frame_level, Osequence *O, const bool forward);
 
+		// retire the clauses of O[frame_level] by a unit clause on its flag, and take a new flag for the level. The frame is empty in the solver then.
+		void retire_frame(Osequence *O, const int frame_level);
+
 		void add_clause_from_cube(const Cube &cu, const int frame_level, Osequence *O, const bool forward);
 
 		void shrink_model(Assignment &model);
 
+		// the order of the UC: see Strategy::last_first and Strategy::front_flag.
+		inline void set_uc_order(bool last_first, bool front_flag) { last_first_ = last_first; front_flag_ = front_flag; }
+
 	public:
 		// This section is for bi-car
 
@@ -97,6 +129,8 @@ namespace car
 		int max_flag;
         bool rotate_is_on;
         bool uc_no_sort;
+		bool last_first_ = false;
+		bool front_flag_ = false;
 	};
 
 }
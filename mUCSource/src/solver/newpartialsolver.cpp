@@ -5,26 +5,13 @@
 using namespace std;
 namespace car
 {
-	PartialSolver::PartialSolver (Model* m, const bool verbose) 
+	PartialSolver::PartialSolver (Model* m, const bool verbose) : CARSolver (ROLE_PARTIAL)
 	{
 		model_ = m;
 		max_partial_id = m->max_id() +1;
 
-	    //constraints
-		for (int i = 0; i < m->outputs_start (); i ++)
-		{
-			add_clause (m->element (i));
-		}
-		//outputs
-		for (int i = m->outputs_start (); i < m->latches_start (); i ++)
-		{
-			add_clause (m->element (i));
-		}
-		//latches
-		for (int i = m->latches_start (); i < m->size (); i ++)
-		{
-			add_clause (m->element (i));
-		}
+	    //constraints, outputs and latches
+		load_model (m, m->size ());
 
 	}
 	
@@ -66,7 +53,7 @@ namespace car
 		assumptions.clear ();
 		for (const int &var :assum)
 		{
-			assumptions.push (SAT_lit (var));
+			assumptions.push_back (var);
 		}
 	}
 }
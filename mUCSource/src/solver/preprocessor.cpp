@@ -0,0 +1,80 @@
+#include "preprocessor.h"
+#include "simp/SimpSolver.h"
+#include <assert.h>
+using namespace std;
+#ifdef MINISAT
+	using namespace Minisat;
+#else
+	using namespace Glucose;
+#endif
+
+namespace car
+{
+	class Preprocessor::Impl : public SimpSolver
+	{
+	public:
+		Lit SAT_lit (const int id)
+		{
+			assert (id != 0);
+			int var = abs (id) - 1;
+			while (var >= nVars ())
+				newVar ();
+			return ((id > 0) ? mkLit (var) : ~mkLit (var));
+		}
+
+		int lit_id (Lit l) const
+		{
+			return sign (l) ? -(var (l) + 1) : var (l) + 1;
+		}
+
+		bool export_clauses (vector<vector<int>>& res);
+	};
+
+	Preprocessor::Preprocessor () : impl_ (new Impl ()) {}
+
+	Preprocessor::~Preprocessor ()
+	{
+		delete impl_;
+	}
+
+	void Preprocessor::freeze (const int id)
+	{
+		impl_->setFrozen (var (impl_->SAT_lit (id)), true);
+	}
+
+	void Preprocessor::add_clause (const ClauseView& cl)
+	{
+		vec<Lit> lits (cl.size ());
+		for (int i = 0; i < cl.size (); ++i)
+			lits[i] = impl_->SAT_lit (cl[i]);
+		impl_->addClause (lits);
+	}
+
+	bool Preprocessor::simplify (vector<vector<int>>& res)
+	{
+		return impl_->export_clauses (res);
+	}
+
+	bool Preprocessor::Impl::export_clauses (vector<vector<int>>& res)
+	{
+		if (!okay () || !eliminate (true))
+			return false;
+
+		res.clear ();
+		// the fixed variables.
+		for (int i = 0; i < trail.size (); ++i)
+			res.push_back ({lit_id (trail[i])});
+		// the remaining clauses. Those of the eliminated variables are already removed.
+		for (int i = 0; i < clauses.size (); ++i)
+		{
+			const auto& c = ca[clauses[i]];
+			if (c.mark ())
+				continue;
+			vector<int> cl (c.size ());
+			for (int j = 0; j < c.size (); ++j)
+				cl[j] = lit_id (c[j]);
+			res.push_back (cl);
+		}
+		return true;
+	}
+}
@@ -0,0 +1,40 @@
+#ifndef PREPROCESSOR_H
+#define PREPROCESSOR_H
+
+#include "basic_data.h"
+#include <vector>
+
+namespace car
+{
+	/**
+	 * @brief SatELite-style preprocessing of a set of clauses: bounded variable elimination, subsumption and self-subsumption.
+	 * Frozen variables are never eliminated, so the result is equisatisfiable with the input under any assignment to them.
+	 * It is used once on the model, not for solving.
+	 * It runs on the SimpSolver of the backend chosen by SOLVER, whose headers are only seen by preprocessor.cpp.
+	 */
+	class Preprocessor
+	{
+	public:
+		Preprocessor ();
+		~Preprocessor ();
+		Preprocessor (const Preprocessor &) = delete;
+		Preprocessor &operator= (const Preprocessor &) = delete;
+
+		void freeze (const int id);
+		void add_clause (const ClauseView& cl);
+
+		/**
+		 * @brief run the preprocessing.
+		 *
+		 * @param res the simplified clauses, units of the fixed variables come first.
+		 * @return false if the clauses are found UNSAT, and res is left untouched.
+		 */
+		bool simplify (std::vector<std::vector<int>>& res);
+
+	private:
+		class Impl;
+		Impl *impl_;
+	};
+}
+
+#endif
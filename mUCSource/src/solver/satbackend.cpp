@@ -0,0 +1,41 @@
+#include "satbackend.h"
+
+namespace car
+{
+	SatBackend *new_backend (const SatBackendKind kind)
+	{
+		switch (kind)
+		{
+		case SatBackendKind::glucose4:
+			return new_glucose4_backend ();
+		case SatBackendKind::minisat:
+			return new_minisat_backend ();
+		default:
+			return new_glucose_backend ();
+		}
+	}
+
+	SatBackendKind default_backend ()
+	{
+#if defined(MINISAT)
+		return SatBackendKind::minisat;
+#elif defined(GLUCOSE4)
+		return SatBackendKind::glucose4;
+#else
+		return SatBackendKind::glucose;
+#endif
+	}
+
+	bool parse_backend (const std::string &name, SatBackendKind &kind)
+	{
+		if (name == "glucose")
+			kind = SatBackendKind::glucose;
+		else if (name == "glucose4")
+			kind = SatBackendKind::glucose4;
+		else if (name == "minisat")
+			kind = SatBackendKind::minisat;
+		else
+			return false;
+		return true;
+	}
+}
@@ -0,0 +1,82 @@
+#ifndef SAT_BACKEND_H
+#define SAT_BACKEND_H
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+namespace car
+{
+	// the vendored SAT solvers, all of them are linked. They are named as on the command line.
+	// NOTE: not `Glucose`, which is renamed by the macro of the glucose-4.2.1 build.
+	enum class SatBackendKind
+	{
+		glucose,	// src/sat/glucose
+		glucose4,	// src/sat/glucose-4.2.1, with LCM
+		minisat		// src/sat/minisat
+	};
+
+	// the solvers of the checker, each of them picks its own backend.
+	enum SolverRole
+	{
+		ROLE_MAIN = 0,
+		ROLE_IMPLY,
+		ROLE_INV,
+		ROLE_START,
+		ROLE_PARTIAL,
+		ROLE_NUM
+	};
+
+	/**
+	 * @brief The interface of a SAT solver, with literals as the ids of the model (nonzero ints, negative for negation).
+	 * Variables are created on demand when a literal is met.
+	 * Each backend is implemented in its own translation unit, the only one that sees the headers of that solver.
+	 */
+	class SatBackend
+	{
+	public:
+		virtual ~SatBackend () {}
+
+		// add the or clause. Return false if the solver becomes UNSAT at the top level.
+		virtual bool add_clause (const int *lits, const int sz) = 0;
+		// solve under the assumption. true if SAT.
+		virtual bool solve_assumption (const std::vector<int> &assumption) = 0;
+		// solve under the assumption, but give up after `budget` propagations. true only if it is found UNSAT.
+		virtual bool unsat_within (const std::vector<int> &assumption, const int64_t budget) = 0;
+
+		// the value of var in the last model: var, -var, or 0 if it is unassigned.
+		virtual int model_value (const int var) const = 0;
+		// the whole last model, unassigned variables are taken as false.
+		virtual void get_model (std::vector<int> &res) const = 0;
+		// the assumptions the last UNSAT answer relies on. They are negated, so res is a clause.
+		virtual void get_conflict (std::vector<int> &res) const = 0;
+
+		virtual int num_vars () const = 0;
+		virtual int num_clauses () const = 0;
+		// simplify the clause database at the top level.
+		virtual void simplify_db () = 0;
+		// glucose only: make the search friendlier to many incremental calls.
+		virtual void set_incremental () {}
+
+		/**
+		 * @brief a new solver of the same backend, with the same variables, units and clauses.
+		 * @pre this solver is at the top level, and simplified.
+		 */
+		virtual SatBackend *copy () const = 0;
+		// the clauses in the database, for the printers.
+		virtual void get_clauses (std::vector<std::vector<int>> &res) const = 0;
+	};
+
+	// one factory for each backend.
+	SatBackend *new_glucose_backend ();
+	SatBackend *new_glucose4_backend ();
+	SatBackend *new_minisat_backend ();
+
+	SatBackend *new_backend (const SatBackendKind kind);
+	// the backend chosen by SOLVER when building.
+	SatBackendKind default_backend ();
+	// "glucose", "glucose4" or "minisat". Return false if the name is unknown.
+	bool parse_backend (const std::string &name, SatBackendKind &kind);
+}
+
+#endif
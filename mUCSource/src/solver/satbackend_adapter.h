@@ -0,0 +1,149 @@
+/**
+ * @file satbackend_adapter.h
+ * @brief the SatBackend over a vendored solver.
+ * It is included by the translation unit of each backend only, after `using namespace <the solver>;`,
+ * so that Solver, Lit, vec and lbool are the ones of that solver.
+ * Define SAT_ADAPTER_INCREMENTAL before including it if the solver has setIncrementalMode().
+ */
+#include "satbackend.h"
+#include <assert.h>
+#include <stdlib.h>
+
+namespace
+{
+	class Adapter : public car::SatBackend, public Solver
+	{
+	public:
+		bool add_clause (const int *lits_in, const int sz) override
+		{
+			vec<Lit> lits (sz);
+			for (int i = 0; i < sz; ++i)
+				lits[i] = SAT_lit (lits_in[i]);
+			return addClause (lits);
+		}
+
+		bool solve_assumption (const std::vector<int> &assumption) override
+		{
+			set_assumption (assumption);
+			lbool res = solve_ ();
+			// no budget is set here, the solver must decide.
+			assert (res != l_Undef);
+			if (res == l_Undef)
+				abort ();
+			return res == l_True;
+		}
+
+		bool unsat_within (const std::vector<int> &assumption, const int64_t budget) override
+		{
+			set_assumption (assumption);
+			setPropBudget (budget);
+			lbool res = solve_ ();
+			// the budget must not outlive this call, or the next solve_assumption() may give up.
+			budgetOff ();
+			return res == l_False;
+		}
+
+		int model_value (const int var) const override
+		{
+			if (model[var - 1] == l_True)
+				return var;
+			else if (model[var - 1] == l_False)
+				return -var;
+			return 0;
+		}
+
+		void get_model (std::vector<int> &res) const override
+		{
+			res.resize (nVars (), 0);
+			for (int i = 0; i < nVars (); ++i)
+			{
+				if (model[i] == l_True)
+					res[i] = i + 1;
+				else
+					res[i] = -(i + 1);
+			}
+		}
+
+		void get_conflict (std::vector<int> &res) const override
+		{
+			res.resize (conflict.size (), 0);
+			for (int k = 0; k < conflict.size (); ++k)
+				res[k] = lit_id (conflict[k]);
+		}
+
+		int num_vars () const override { return nVars (); }
+		int num_clauses () const override { return nClauses (); }
+		void simplify_db () override { Solver::simplify (); }
+#ifdef SAT_ADAPTER_INCREMENTAL
+		void set_incremental () override { setIncrementalMode (); }
+#endif
+
+		/**
+		 * @brief copy the variables, units and clause database, without going through addClause() again.
+		 * @note after simplify(), the first two literals of each clause are not false, so the clauses can be watched as they are.
+		 */
+		car::SatBackend *copy () const override
+		{
+			Adapter *res = new Adapter ();
+			if (!okay ())
+			{
+				vec<Lit> empty;
+				res->addClause (empty);
+				return res;
+			}
+
+			while (res->nVars () < nVars ())
+				res->newVar ();
+			for (int i = 0; i < trail.size (); ++i)
+			{
+				vec<Lit> unit;
+				unit.push (trail[i]);
+				res->addClause (unit);
+			}
+			for (int i = 0; i < clauses.size (); ++i)
+			{
+				CRef cr = res->ca.alloc (ca[clauses[i]], false);
+				res->clauses.push (cr);
+				res->attachClause (cr);
+			}
+			return res;
+		}
+
+		void get_clauses (std::vector<std::vector<int>> &res) const override
+		{
+			res.clear ();
+			for (int i = 0; i < clauses.size (); ++i)
+			{
+				const auto &c = ca[clauses[i]];
+				std::vector<int> cl (c.size ());
+				for (int j = 0; j < c.size (); ++j)
+					cl[j] = lit_id (c[j]);
+				res.push_back (cl);
+			}
+		}
+
+	private:
+		// int -> SAT lit, the variables are created on demand.
+		Lit SAT_lit (const int id)
+		{
+			assert (id != 0);
+			int var = abs (id) - 1;
+			while (var >= nVars ())
+				newVar ();
+			return ((id > 0) ? mkLit (var) : ~mkLit (var));
+		}
+
+		// SAT lit -> int
+		int lit_id (Lit l) const
+		{
+			return sign (l) ? -(var (l) + 1) : var (l) + 1;
+		}
+
+		void set_assumption (const std::vector<int> &assumption)
+		{
+			assumptions.clear ();
+			for (int id : assumption)
+				assumptions.push (SAT_lit (id));
+		}
+	};
+}
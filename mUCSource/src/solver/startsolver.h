@@ -10,16 +10,15 @@ namespace car {
     extern Statistics CARStats;
     class StartSolver : public CARSolver {
     public:
-        StartSolver (const Model* m, const int bad, const bool forward, const bool verbose = false)
+        StartSolver (const Model* m, const int bad, const bool forward, const bool verbose = false) : CARSolver (ROLE_START)
         {
             if (!forward)
                 add_cube (const_cast<Model*>(m)->init ());
             else
             {
                 // FIXME: what does here mean?
-                for (int i = 0; i < const_cast<Model*>(m)->latches_start (); i ++)
-                    add_clause (const_cast<Model*>(m)->element (i));
-                assumptions.push (SAT_lit (bad));
+                load_model (m, m->latches_start ());
+                assumptions.push_back (bad);
             }
             model_ = m;
             forward_ = forward;
@@ -38,17 +37,19 @@ namespace car {
         
         // block last flag, and set a new flag.
         // NOTE: Together with "add_clause_with_flag()", this makes sure all the clauses inserted before are invalidated.
+        // The last flag is fixed by a unit clause and replaced in the assumption, which keeps its size.
+        // Its clauses are satisfied from then on, and simplify() removes them.
         inline void reset ()
         {
             if(fresh)
             {
                 fresh = false;
-                assumptions.push (SAT_lit (flag_));
+                assumptions.push_back (flag_);
                 return;
             }
-            assumptions.pop();
-            assumptions.push(~SAT_lit (flag_));
-            assumptions.push(SAT_lit (++flag_));
+            add_clause (-flag_);
+            assumptions.back() = ++flag_;
+            simplify ();
         }
 
         // This method is temporarily add, will be blocked later by reset().
@@ -78,19 +79,9 @@ namespace car {
             int nlatches = model_->num_latches();
             Assignment inputs(ninputs), latches(nlatches);
             for (int i = 0; i <ninputs ; i ++)
-            {
-                if (model[i] == l_True)
-                    inputs[i] = i+1;
-                else if (model[i] == l_False)
-                    inputs[i] = -(i+1);
-            }
+                inputs[i] = model_value (i+1);
             for (int i = 0; i < nlatches ; i ++)
-            {
-                if (model[i+ninputs] == l_True)
-                    latches[i] = i+1+ninputs;
-                else if (model[i+ninputs] == l_False)
-                    latches[i] = -(i+1+ninputs);
-            }
+                latches[i] = model_value (i+1+ninputs);
 			State *res = new State(inputs,latches);
 			return res;
         }
@@ -0,0 +1,123 @@
+#include "ucdiversifier.h"
+#include <algorithm>
+#include <random>
+
+namespace car
+{
+    UCDiversifier::UCDiversifier(MainSolver *main, Model *model, int rotate_is_on, bool uc_no_sort, bool last_first, bool front_flag, int workers, int64_t budget) : main_(main), replayed_(workers, 0), budget_(budget), results_(workers)
+    {
+        for (int i = 0; i < workers; ++i)
+        {
+            MainSolver *clone = new MainSolver(model, rotate_is_on, false, uc_no_sort);
+            clone->set_uc_order(last_first, front_flag);
+            clones_.push_back(clone);
+        }
+        main_->add_journal(&journal_);
+        for (int i = 0; i < workers; ++i)
+            threads_.emplace_back(&UCDiversifier::work, this, i);
+    }
+
+    UCDiversifier::~UCDiversifier()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mtx_);
+            stop_ = true;
+        }
+        cv_job_.notify_all();
+        for (auto &t : threads_)
+            t.join();
+        main_->remove_journal(&journal_);
+        for (auto *clone : clones_)
+            delete clone;
+    }
+
+    void UCDiversifier::diversify(const bool forward, std::vector<Cube> &ucs)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mtx_);
+            assumption_ = main_->get_assumption();
+            forward_ = forward;
+            pending_ = clones_.size();
+            ++job_id_;
+        }
+        cv_job_.notify_all();
+
+        // it does not add clauses, the clones can read the journal.
+        Cube own = main_->get_conflict_another(forward);
+
+        std::unique_lock<std::mutex> lock(mtx_);
+        cv_done_.wait(lock, [this]
+                      { return pending_ == 0; });
+        // all the clones are up to date.
+        journal_.clear();
+        std::fill(replayed_.begin(), replayed_.end(), 0);
+
+        ucs.clear();
+        ucs.push_back(std::move(own));
+        for (auto &uc : results_)
+            if (!uc.empty())
+                ucs.push_back(std::move(uc));
+    }
+
+    void UCDiversifier::reorder(int index, std::vector<int> &assumption, long job)
+    {
+        if (assumption.size() < 3)
+            return;
+        auto first = assumption.begin() + 1;
+        switch (index)
+        {
+        case 0:
+            std::rotate(first, first + (assumption.size() - 1) / 2, assumption.end());
+            break;
+        default:
+        {
+            std::mt19937 rng(job * 131 + index);
+            std::shuffle(first, assumption.end(), rng);
+            break;
+        }
+        }
+    }
+
+    void UCDiversifier::work(int index)
+    {
+        long done = 0;
+        MainSolver *clone = clones_[index];
+        while (true)
+        {
+            std::vector<int> assumption;
+            bool forward;
+            {
+                std::unique_lock<std::mutex> lock(mtx_);
+                cv_job_.wait(lock, [this, done]
+                             { return stop_ || job_id_ != done; });
+                if (stop_)
+                    return;
+                done = job_id_;
+                assumption = assumption_;
+                forward = forward_;
+            }
+
+            // the main thread does not add clauses while it waits.
+            size_t &pos = replayed_[index];
+            while (pos < journal_.size())
+            {
+                int sz = journal_[pos];
+                clone->add_clause_internal(journal_.data() + pos + 1, sz);
+                pos += sz + 1;
+            }
+
+            reorder(index, assumption, done);
+            clone->load_assumption(assumption);
+            Cube uc;
+            if (clone->unsat_within(budget_))
+                uc = clone->get_conflict(forward);
+
+            {
+                std::lock_guard<std::mutex> lock(mtx_);
+                results_[index] = std::move(uc);
+                if (--pending_ == 0)
+                    cv_done_.notify_one();
+            }
+        }
+    }
+}
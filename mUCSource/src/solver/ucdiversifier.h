@@ -0,0 +1,56 @@
+#ifndef UC_DIVERSIFIER_H
+#define UC_DIVERSIFIER_H
+
+#include "mainsolver.h"
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+namespace car
+{
+    /**
+     * @brief Re-solve a failed query of the main solver on clones of it, each with its own order of the assumption, all at once.
+     * The main solver itself reverses the assumption meanwhile, as get_uc_another() does.
+     * The clones replay the clauses added to the main solver since their last call, see CARSolver::add_journal().
+     * Their orders are, by worker: rotated by half, then shuffled with a seed of its own. The flag of the frame stays the first one in all of them.
+     * The clones lack the clauses the main solver learnt in the query, so they give up after a budget of propagations.
+     */
+    class UCDiversifier
+    {
+    public:
+        UCDiversifier(MainSolver *main, Model *model, int rotate_is_on, bool uc_no_sort, bool last_first, bool front_flag, int workers, int64_t budget = 100000);
+        ~UCDiversifier();
+
+        /**
+         * @brief the UCs of the last query of the main solver: the one of the main solver, then those of the clones within the budget.
+         * @pre the last call of the main solver was UNSAT.
+         */
+        void diversify(const bool forward, std::vector<Cube> &ucs);
+
+    private:
+        MainSolver *main_;
+        std::vector<MainSolver *> clones_;
+        std::vector<std::thread> threads_;
+        // the clauses added to the main solver: [size, lit, lit, ...], and how far each clone has replayed it.
+        std::vector<int> journal_;
+        std::vector<size_t> replayed_;
+        int64_t budget_;
+
+        // the current job.
+        std::vector<int> assumption_;
+        bool forward_ = false;
+        std::vector<Cube> results_;
+
+        std::mutex mtx_;
+        std::condition_variable cv_job_, cv_done_;
+        long job_id_ = 0;
+        int pending_ = 0;
+        bool stop_ = false;
+
+        void work(int index);
+        void reorder(int index, std::vector<int> &assumption, long job);
+    };
+}
+
+#endif
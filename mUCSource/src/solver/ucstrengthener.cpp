@@ -0,0 +1,108 @@
+#include "ucstrengthener.h"
+#include <algorithm>
+
+namespace car
+{
+    UCStrengthener::UCStrengthener(MainSolver *main, Model *model, int rotate_is_on, bool uc_no_sort, bool last_first, bool front_flag, int attempts, int64_t budget, int capacity) : main_(main), attempts_(attempts), budget_(budget), capacity_(capacity)
+    {
+        worker_ = new MainSolver(model, rotate_is_on, false, uc_no_sort);
+        worker_->set_uc_order(last_first, front_flag);
+        main_->add_journal(&journal_);
+        thread_ = std::thread(&UCStrengthener::work, this);
+    }
+
+    UCStrengthener::~UCStrengthener()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mtx_);
+            stop_ = true;
+        }
+        cv_.notify_one();
+        thread_.join();
+        main_->remove_journal(&journal_);
+        delete worker_;
+    }
+
+    void UCStrengthener::submit(Osequence *O, int level, const Cube &uc, const bool forward)
+    {
+        // the flags are looked up here, since the map of them is not shared with the worker.
+        int flag = main_->flag_of(O, level);
+        {
+            std::lock_guard<std::mutex> lock(mtx_);
+            inbox_.insert(inbox_.end(), journal_.begin(), journal_.end());
+            jobs_.push_back({O, level + 1, flag, uc, forward});
+            if (jobs_.size() > capacity_)
+            {
+                jobs_.pop_front();
+                ++dropped_;
+            }
+        }
+        journal_.clear();
+        cv_.notify_one();
+    }
+
+    void UCStrengthener::collect(std::vector<Result> &res)
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        res.swap(results_);
+        results_.clear();
+        ready_.store(false, std::memory_order_release);
+    }
+
+    void UCStrengthener::forget(Osequence *O)
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        jobs_.erase(std::remove_if(jobs_.begin(), jobs_.end(), [O](const Job &j)
+                                   { return j.O == O; }),
+                    jobs_.end());
+        results_.erase(std::remove_if(results_.begin(), results_.end(), [O](const Result &r)
+                                      { return r.O == O; }),
+                       results_.end());
+        // the job in hand is not published.
+        if (busy_ == O)
+            cancelled_ = true;
+    }
+
+    long UCStrengthener::take_dropped()
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        long res = dropped_;
+        dropped_ = 0;
+        return res;
+    }
+
+    void UCStrengthener::work()
+    {
+        std::vector<int> clauses;
+        while (true)
+        {
+            Job job;
+            {
+                std::unique_lock<std::mutex> lock(mtx_);
+                cv_.wait(lock, [this]
+                         { return stop_ || !jobs_.empty(); });
+                if (stop_)
+                    return;
+                clauses.swap(inbox_);
+                job = std::move(jobs_.front());
+                jobs_.pop_front();
+                busy_ = job.O;
+                cancelled_ = false;
+            }
+
+            for (size_t pos = 0; pos < clauses.size(); pos += clauses[pos] + 1)
+                worker_->add_clause_internal(clauses.data() + pos + 1, clauses[pos]);
+            clauses.clear();
+
+            Cube uc = job.uc;
+            worker_->shrink_uc(job.flag, uc, job.forward, attempts_, budget_);
+
+            std::lock_guard<std::mutex> lock(mtx_);
+            busy_ = nullptr;
+            if (cancelled_ || uc.size() >= job.uc.size())
+                continue;
+            results_.push_back({job.O, job.dst, std::move(uc), int(job.uc.size())});
+            ready_.store(true, std::memory_order_release);
+        }
+    }
+}
@@ -0,0 +1,83 @@
+#ifndef UC_STRENGTHENER_H
+#define UC_STRENGTHENER_H
+
+#include "mainsolver.h"
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <condition_variable>
+
+namespace car
+{
+    /**
+     * @brief Shorten the UCs of the main solver on a thread of its own, while the search goes on with the raw ones.
+     * The worker has a clone of the main solver, which replays the clauses added to the main solver, see CARSolver::add_journal().
+     * It only ever has a subset of those clauses, so a UC it proves is also one of the main solver.
+     * The search never waits: it submits a UC and later collects the shorter ones, see Checker::collectStrengthened().
+     * If the worker falls behind, the oldest UCs in the queue are dropped.
+     */
+    class UCStrengthener
+    {
+    public:
+        struct Result
+        {
+            Osequence *O;
+            // the level of the frame the UC goes to.
+            int dst;
+            Cube uc;
+            // the length of the raw UC.
+            int len_before;
+        };
+
+        UCStrengthener(MainSolver *main, Model *model, int rotate_is_on, bool uc_no_sort, bool last_first, bool front_flag, int attempts, int64_t budget, int capacity = 256);
+        ~UCStrengthener();
+
+        // queue uc, the UC of a failed query of O[level], which went to O[level+1].
+        void submit(Osequence *O, int level, const Cube &uc, const bool forward);
+        // whether there are shorter UCs to collect.
+        inline bool ready() const { return ready_.load(std::memory_order_acquire); }
+        // move the shorter UCs published since the last call to res.
+        void collect(std::vector<Result> &res);
+        // drop the jobs and the results of O, before it is deleted.
+        void forget(Osequence *O);
+        // the number of UCs dropped from a full queue since the last call.
+        long take_dropped();
+
+    private:
+        struct Job
+        {
+            Osequence *O;
+            int dst;
+            int flag;
+            Cube uc;
+            bool forward;
+        };
+
+        MainSolver *main_;
+        MainSolver *worker_;
+        int attempts_;
+        int64_t budget_;
+        int capacity_;
+        // the clauses added to the main solver, written by the search thread only. They move to inbox_ on submit().
+        std::vector<int> journal_;
+        std::vector<int> inbox_;
+        std::deque<Job> jobs_;
+        std::vector<Result> results_;
+        long dropped_ = 0;
+        // the O of the job the worker is on, and whether it was forgotten meanwhile.
+        Osequence *busy_ = nullptr;
+        bool cancelled_ = false;
+
+        std::thread thread_;
+        std::mutex mtx_;
+        std::condition_variable cv_;
+        std::atomic<bool> ready_{false};
+        bool stop_ = false;
+
+        void work();
+    };
+}
+
+#endif
@@ -0,0 +1,95 @@
+#ifndef BANDIT_H
+#define BANDIT_H
+
+#include <stdint.h>
+#include <vector>
+#include <chrono>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+namespace car
+{
+    // a cheap timestamp for comparing costs, not for reporting time: cycles where the CPU has a counter, nanoseconds otherwise.
+    inline uint64_t cycle_count()
+    {
+#if defined(__x86_64__) || defined(__i386__)
+        return __rdtsc();
+#elif defined(__aarch64__)
+        uint64_t v;
+        asm volatile("mrs %0, cntvct_el0" : "=r"(v));
+        return v;
+#else
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+    }
+
+    /**
+     * @brief A multi-armed bandit for each level, which minimizes the cost of the calls.
+     * Each arm is first tried `warmup` times at a level, then the one with the lowest moving average of cost is picked,
+     * except that every `period` calls all the arms are sampled once again, since the costs change as the frames grow.
+     */
+    class LevelBandit
+    {
+    public:
+        LevelBandit(const std::vector<int> &arms, int period = 256, int warmup = 4) : arms_(arms), period_(period), warmup_(warmup) {}
+
+        inline const std::vector<int> &arms() const { return arms_; }
+
+        // the index of the arm to use at the level.
+        int pick(int level)
+        {
+            Level &l = at(level);
+            ++l.calls;
+            int least = 0;
+            for (int i = 1; i < arms_.size(); ++i)
+                if (l.tries[i] < l.tries[least])
+                    least = i;
+            if (l.tries[least] < warmup_)
+                return least;
+            int phase = l.calls % period_;
+            if (phase < arms_.size())
+                return phase;
+            int best = 0;
+            for (int i = 1; i < arms_.size(); ++i)
+                if (l.cost[i] < l.cost[best])
+                    best = i;
+            return best;
+        }
+
+        // the cost of the last call with the arm at the level.
+        void reward(int level, int arm, uint64_t cost)
+        {
+            Level &l = at(level);
+            ++l.tries[arm];
+            // a plain average during the warmup, then the recent calls weigh 1/8.
+            double rate = l.tries[arm] < 8 ? 1.0 / l.tries[arm] : 0.125;
+            l.cost[arm] += (double(cost) - l.cost[arm]) * rate;
+        }
+
+    private:
+        struct Level
+        {
+            long calls = 0;
+            std::vector<long> tries;
+            std::vector<double> cost;
+        };
+        std::vector<int> arms_;
+        int period_;
+        int warmup_;
+        std::vector<Level> levels_;
+
+        Level &at(int level)
+        {
+            while (levels_.size() <= level)
+            {
+                levels_.emplace_back();
+                levels_.back().tries.assign(arms_.size(), 0);
+                levels_.back().cost.assign(arms_.size(), 0.0);
+            }
+            return levels_[level];
+        }
+    };
+}
+
+#endif
@@ -1,6 +1,9 @@
 #ifndef BASIC_DATA_H
 #define BASIC_DATA_H
 #include <vector>
+#include <cstddef>
+#include <initializer_list>
+#include <utility>
 namespace car
 {
     /* 1-100
@@ -12,9 +15,76 @@ namespace car
 	typedef std::vector<int> Cube;
 	// a \/ b \/ c
 	typedef std::vector<int> Clause;
+	/**
+	 * @brief A handle of a UC in the UC store, where each distinct UC is stored once, with a reference count.
+	 * It reads as a const Cube. The frames, and the implication engines of the levels, share the same copy, and its activity.
+	 */
+	class UC
+	{
+	public:
+		UC() : n_(intern(Cube())) {}
+		UC(const Cube &cu) : n_(intern(cu)) {}
+		UC(std::initializer_list<int> lits) : n_(intern(Cube(lits))) {}
+		UC(const UC &o) : n_(o.n_) { ++n_->refs; }
+		UC(UC &&o) noexcept : n_(o.n_) { o.n_ = nullptr; }
+		UC &operator=(UC o) noexcept
+		{
+			std::swap(n_, o.n_);
+			return *this;
+		}
+		~UC()
+		{
+			if (n_ && --n_->refs == 0)
+				release(n_);
+		}
+
+		inline operator const Cube &() const { return n_->lits; }
+		inline const Cube &cube() const { return n_->lits; }
+		inline Cube::const_iterator begin() const { return n_->lits.begin(); }
+		inline Cube::const_iterator end() const { return n_->lits.end(); }
+		inline int size() const { return n_->lits.size(); }
+		inline bool empty() const { return n_->lits.empty(); }
+		inline int operator[](int i) const { return n_->lits[i]; }
+		inline int front() const { return n_->lits.front(); }
+		inline int back() const { return n_->lits.back(); }
+
+		// how often the UC blocked a state, or was learnt again. It is shared by all the frames of the UC.
+		inline long activity() const { return n_->activity; }
+		inline void bump() const { ++n_->activity; }
+		// halve the activity, so that the old hits weigh less.
+		inline void decay() const { n_->activity >>= 1; }
+
+		// number of distinct UCs in the store, now and at most.
+		static size_t store_size();
+		static size_t store_peak();
+
+	private:
+		struct Node
+		{
+			Cube lits;
+			long refs;
+			long activity;
+		};
+		Node *n_;
+
+		static Node *intern(const Cube &cu);
+		static void release(Node *n);
+	};
+
 	// ~(c1 \/ c2 \/ c3)  c_i都是uc，不用管初始化（全集？）的问题
-	typedef std::vector<Cube> Frame;
+	typedef std::vector<UC> Frame;
 	//
 	typedef std::vector<Frame> Fsequence;
+
+	// a read-only view of one clause, which is stored in a flat literal array (see Model).
+	struct ClauseView
+	{
+		const int *lits;
+		int sz;
+		inline const int *begin() const { return lits; }
+		inline const int *end() const { return lits + sz; }
+		inline int size() const { return sz; }
+		inline int operator[](int i) const { return lits[i]; }
+	};
 }
 #endif
\ No newline at end of file
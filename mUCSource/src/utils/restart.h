@@ -0,0 +1,77 @@
+#ifndef RESTART_H
+#define RESTART_H
+
+namespace car
+{
+    enum RestartKind
+    {
+        // every --restart seconds of wall time.
+        Restart_Time = 0,
+        // unit times the Luby sequence 1 1 2 1 1 2 4 ..., in SAT calls.
+        Restart_Luby = 1,
+        // unit, unit * 1.5, unit * 1.5^2 ..., in SAT calls.
+        Restart_Geometric = 2
+    };
+
+    /**
+     * @brief The intervals between restarts, counted in queries of the main solver, so that the restarts do not depend on the speed of the machine.
+     * It is copied into the checker of the next restart, which goes on with the next interval.
+     */
+    class RestartPolicy
+    {
+    public:
+        RestartPolicy(int kind = Restart_Time, long unit = 1000) : kind_(kind), unit_(unit) { limit_ = interval(); }
+
+        inline int kind() const { return kind_; }
+
+        // count one query, and whether the interval is over. The next interval starts then.
+        bool tick()
+        {
+            if (++calls_ < limit_)
+                return false;
+            calls_ = 0;
+            ++index_;
+            limit_ = interval();
+            return true;
+        }
+
+    private:
+        int kind_;
+        long unit_;
+        int index_ = 0;
+        long calls_ = 0;
+        long limit_ = 0;
+
+        long interval() const
+        {
+            if (kind_ == Restart_Geometric)
+            {
+                double res = unit_;
+                for (int i = 0; i < index_; ++i)
+                    res *= 1.5;
+                return long(res);
+            }
+            return unit_ * luby(index_);
+        }
+
+        // the x-th element of the Luby sequence, from 0.
+        static long luby(int x)
+        {
+            int size = 1, seq = 0;
+            while (size < x + 1)
+            {
+                ++seq;
+                size = 2 * size + 1;
+            }
+            while (size - 1 != x)
+            {
+                size = (size - 1) >> 1;
+                --seq;
+                x = x % size;
+            }
+            return 1L << seq;
+        }
+    };
+}
+
+#endif
@@ -6,6 +6,7 @@
 #include <string>
 #include <map>
 #include <chrono>
+#include "basic_data.h"
 using namespace std::chrono;
 using std::__cxx11::to_string;
 using clock_high = steady_clock::time_point;
@@ -211,6 +212,141 @@ class Statistics
             return imply_decision;
         }
 
+        // generalization of the UCs by dropping literals, for each level the UC goes to.
+        struct GeneralizeStat
+        {
+            long calls = 0;
+            long attempts = 0;
+            long dropped = 0;
+            long len_before = 0;
+            long len_after = 0;
+            double time = 0.0;
+        };
+        std::map<int, GeneralizeStat> generalize_stats;
+        clock_high generalize_begin_;
+        inline void count_generalize_begin()
+        {
+#ifdef STAT
+            generalize_begin_ = steady_clock::now();
+#endif
+        }
+        inline void count_generalize_end(int level, int attempts, int len_before, int len_after)
+        {
+            GeneralizeStat &st = generalize_stats[level];
+#ifdef STAT
+            duration_high elapsed = steady_clock::now() - generalize_begin_;
+            st.time += elapsed.count();
+#endif
+            st.calls++;
+            st.attempts += attempts;
+            st.dropped += len_after < len_before ? 1 : 0;
+            st.len_before += len_before;
+            st.len_after += len_after;
+        }
+
+        // pushing the UCs to the next frame between the rounds.
+        long propagate_tried = 0;
+        long propagate_pushed = 0;
+        double propagate_time = 0.0;
+        clock_high propagate_begin_;
+        inline void count_propagate_begin()
+        {
+#ifdef STAT
+            propagate_begin_ = steady_clock::now();
+#endif
+        }
+        inline void count_propagate_end(long tried, long pushed)
+        {
+#ifdef STAT
+            duration_high elapsed = steady_clock::now() - propagate_begin_;
+            propagate_time += elapsed.count();
+#endif
+            propagate_tried += tried;
+            propagate_pushed += pushed;
+        }
+
+        // UCs shortened on the background thread.
+        long async_submitted = 0;
+        long async_published = 0;
+        long async_stale = 0;
+        long async_dropped = 0;
+        long async_lits_removed = 0;
+        inline void count_async_submit() { async_submitted++; }
+        inline void count_async_publish(int len_before, int len_after)
+        {
+            async_published++;
+            async_lits_removed += len_before - len_after;
+        }
+        inline void count_async_stale() { async_stale++; }
+        inline void count_async_dropped(long n) { async_dropped += n; }
+
+        // the queries for several states at once: those that found a state with a successor, those that blocked all with one UC, and the others.
+        long batch_states_queries = 0;
+        long batch_states_sat = 0;
+        long batch_states_shared = 0;
+        long batch_states_fallback = 0;
+        inline void count_batch_states(bool sat, bool shared)
+        {
+            batch_states_queries++;
+            if (sat)
+                batch_states_sat++;
+            else if (shared)
+                batch_states_shared++;
+            else
+                batch_states_fallback++;
+        }
+
+        // the further queries for more successors of a SAT query, and the successors they found.
+        long batch_queries = 0;
+        long batch_states = 0;
+        inline void count_batch(long states)
+        {
+            batch_queries++;
+            batch_states += states;
+        }
+
+        // the successors found again without the main solver, and the cached ones that were blocked by then.
+        long reuse_hits = 0;
+        long reuse_misses = 0;
+        inline void count_reuse(bool hit) { hit ? reuse_hits++ : reuse_misses++; }
+
+        // the reductions of the frames under the budgets, the UCs they dropped: cold ones, and those that no longer hold against the frame below, and the frames dropped.
+        long reductions = 0;
+        long reduce_cold = 0;
+        long reduce_invalid = 0;
+        long reduce_levels = 0;
+        double reduce_time = 0.0;
+        clock_high reduce_begin_;
+        inline void count_reduce_begin()
+        {
+#ifdef STAT
+            reduce_begin_ = steady_clock::now();
+#endif
+        }
+        inline void count_reduce_end(long cold, long invalid, long levels)
+        {
+#ifdef STAT
+            duration_high elapsed = steady_clock::now() - reduce_begin_;
+            reduce_time += elapsed.count();
+#endif
+            reductions++;
+            reduce_cold += cold;
+            reduce_invalid += invalid;
+            reduce_levels += levels;
+        }
+
+        // the strategy switches of --warm.
+        long warm_restarts = 0;
+        inline void count_warm_restart() { warm_restarts++; }
+
+        // the levels where ConvModeStuck fired, and how often.
+        std::map<int,long> stuckFires;
+        inline void record_stuck(int level) { stuckFires[level]++; }
+
+        // the implication methods picked by the bandit, keyed by the method.
+        std::map<int,long> banditPicks;
+        inline void record_bandit_pick(int method) { banditPicks[method]++; }
+
         std::map<int,int> solverWin, manualWin;
         
         inline void record_winner(bool isSolver, int framesz)
@@ -360,8 +496,65 @@ class Statistics
             // std::cout << "      \"Manual\": "    << time_imply_dec_man <<","<<std::endl;
             
             std::cout << "      \"Total Time\": "    << time_imply / 1000.0 <<","<<std::endl;
-            std::cout << "      \"Group Count\": "    << count_imply <<std::endl; 
+            std::cout << "      \"Group Count\": "    << count_imply <<","<<std::endl; 
+            std::cout << "      \"Distinct UCs (peak)\": "    << UC::store_peak() <<std::endl; 
             std::cout << "      },"<<std::endl;
+            if(!generalize_stats.empty())
+            {
+                std::cout << "      \"Generalization\": {" <<std::endl;
+                for (auto it = generalize_stats.begin(); it != generalize_stats.end(); ++it)
+                {
+                    const GeneralizeStat &st = it->second;
+                    std::cout << "      \"" << it->first << "\": {\"Calls\": " << st.calls << ", \"Attempts\": " << st.attempts << ", \"Shortened\": " << st.dropped
+                              << ", \"Length before\": " << float(st.len_before) / st.calls << ", \"Length after\": " << float(st.len_after) / st.calls
+                              << ", \"Time\": " << st.time / 1000.0 << "}" << (std::next(it) == generalize_stats.end() ? "" : ",") << std::endl;
+                }
+                std::cout << "      },"<<std::endl;
+            }
+            if(propagate_tried > 0)
+            {
+                std::cout << "      \"Propagation\": {\"Tried\": " << propagate_tried << ", \"Pushed\": " << propagate_pushed
+                          << ", \"Time\": " << propagate_time / 1000.0 << "}," << std::endl;
+            }
+            if(async_submitted > 0)
+            {
+                std::cout << "      \"Async Strengthening\": {\"Submitted\": " << async_submitted << ", \"Published\": " << async_published
+                          << ", \"Stale\": " << async_stale << ", \"Dropped\": " << async_dropped << ", \"Literals removed\": " << async_lits_removed << "}," << std::endl;
+            }
+            if(batch_states_queries > 0)
+            {
+                std::cout << "      \"Batched Queries\": {\"Queries\": " << batch_states_queries << ", \"SAT\": " << batch_states_sat
+                          << ", \"Shared UC\": " << batch_states_shared << ", \"Fallback\": " << batch_states_fallback << "}," << std::endl;
+            }
+            if(batch_queries > 0)
+            {
+                std::cout << "      \"Successor Batches\": {\"Batches\": " << batch_queries << ", \"More states\": " << batch_states << "}," << std::endl;
+            }
+            if(reuse_hits + reuse_misses > 0)
+            {
+                std::cout << "      \"Successor Reuse\": {\"Hits\": " << reuse_hits << ", \"Misses\": " << reuse_misses << "}," << std::endl;
+            }
+            if(reductions > 0)
+            {
+                std::cout << "      \"Frame Reduction\": {\"Reductions\": " << reductions << ", \"Cold\": " << reduce_cold
+                          << ", \"Invalid\": " << reduce_invalid << ", \"Levels\": " << reduce_levels << ", \"Time\": " << reduce_time / 1000.0 << "}," << std::endl;
+            }
+            if(warm_restarts > 0)
+                std::cout << "      \"Warm Restarts\": " << warm_restarts << "," << std::endl;
+            if(!stuckFires.empty())
+            {
+                std::cout << "      \"Stuck Levels\": {";
+                for (auto it = stuckFires.begin(); it != stuckFires.end(); ++it)
+                    std::cout << (it == stuckFires.begin() ? "" : ", ") << "\"" << it->first << "\": " << it->second;
+                std::cout << "},"<<std::endl;
+            }
+            if(!banditPicks.empty())
+            {
+                std::cout << "      \"Bandit Picks\": {";
+                for (auto it = banditPicks.begin(); it != banditPicks.end(); ++it)
+                    std::cout << (it == banditPicks.begin() ? "" : ", ") << "\"" << it->first << "\": " << it->second;
+                std::cout << "},"<<std::endl;
+            }
             if(!solverWin.empty() || !manualWin.empty())
             {
                 std::cout << "      \"Winning History\": "    <<std::endl; 
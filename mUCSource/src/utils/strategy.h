@@ -0,0 +1,127 @@
+#ifndef STRATEGY_H
+#define STRATEGY_H
+
+namespace car
+{
+	// the order of the parts of the assumption of the main solver. I: a cube of intersection, R: the two parts of the rotation.
+	enum AssumOrder
+	{
+		Ass_Default = 0, // I..I R R
+		Ass_IRRI,
+		Ass_IIRR,
+		Ass_IRIR,
+		Ass_RIRI,
+		Ass_RRII,
+		Ass_RIIR,
+	};
+
+	/**
+	 * @brief Search options, most of which used to be fixed when building.
+	 * Each of them has its command-line option. The Makefile knobs of the same names still work, they set the defaults.
+	 */
+	struct Strategy
+	{
+		AssumOrder ass_order = Ass_Default;
+		// order the state in the assumption by the scores of literals in failed states.
+		bool score = false;
+		bool score_reverse = false; // low -> high
+		bool score_abs = false;		// score variables, instead of literals
+		bool score_decay = false;	// bump with a growing step
+		// pick the next state to try with a priority queue, instead of a stack.
+		bool pqueue = false;
+		// partial states in forward search.
+		bool partial = false;
+		// remove the UCs that are implied by a new one.
+		bool fresh_uc = false;
+		// put the last literal of an intersection cube first, and append it again to the UC.
+		bool last_first = false;
+		// the literal appended to the UC is the first one, instead of the last one.
+		bool front_flag = false;
+		// do not look deeper than the depth of the state in the search tree allows.
+		bool depth = false;
+		// glucose incremental mode of the main solver.
+		bool inc_sat = false;
+		// print the search trail.
+		bool trail = false;
+		// after each round, push the UCs of each frame to the next one if they still hold there.
+		bool propagate = false;
+		// ask whether any of this many states of U has a successor in the top frame with one query, before trying them one by one.
+		int batch_states = 1;
+		// take up to this many successors from each SAT query of the main solver, each further one by another query with the ones found blocked.
+		int batch_successors = 1;
+		// before a query of the main solver, try the successor found for the state the last time: the query is SAT if it is still not blocked.
+		bool reuse_successor = false;
+		// the restart schedule, see RestartKind, and its unit in queries of the main solver.
+		int restart_kind = 0;
+		long restart_unit = 1000;
+		// the part of each frame, in percent, that --rem 5 keeps on a restart: the most active UCs.
+		int retain_percent = 50;
+		// reduce the frames to their most active UCs, half of this many, when they hold more UCs than this in all. Or halve them when the process takes more MB than mem_budget. 0: no limit.
+		long frame_budget = 0;
+		long mem_budget = 0;
+		// with --restart, switch the strategy of the running checker when the time is up, instead of building another one. It keeps the frames, the U sequences and the solvers.
+		bool warm_restart = false;
+		// with convMode, compute another UC on this many clones of the main solver at once, each with another order of the assumption. 0: reverse the assumption in place.
+		int div_workers = 0;
+		// try to drop this many literals from each UC, each try a query of the same frame within mic_budget propagations. 0: off.
+		int mic_attempts = 0;
+		long mic_budget = 10000;
+		// the same, on a thread of its own with a clone of the main solver, while the search goes on with the raw UC. 0: off.
+		int mic_async = 0;
+
+		Strategy ()
+		{
+#if defined(ASS_IRRI)
+			ass_order = Ass_IRRI;
+#elif defined(ASS_IIRR)
+			ass_order = Ass_IIRR;
+#elif defined(ASS_IRIR)
+			ass_order = Ass_IRIR;
+#elif defined(ASS_RIRI)
+			ass_order = Ass_RIRI;
+#elif defined(ASS_RRII)
+			ass_order = Ass_RRII;
+#elif defined(ASS_RIIR)
+			ass_order = Ass_RIIR;
+#endif
+#ifdef SCORE
+			score = true;
+#endif
+#ifdef SCORE_REVERSE
+			score_reverse = true;
+#endif
+#ifdef SCORE_ABS
+			score_abs = true;
+#endif
+#ifdef SCORE_DECAY
+			score_decay = true;
+#endif
+#ifdef PQUEUE
+			pqueue = true;
+#endif
+#ifdef PARTIAL
+			partial = true;
+#endif
+#ifdef FRESH_UC
+			fresh_uc = true;
+#endif
+#ifdef LAST_FIRST
+			last_first = true;
+#endif
+#ifdef FRONT_FLAG
+			front_flag = true;
+#endif
+#ifdef DEPTH
+			depth = true;
+#endif
+#ifdef INC_SAT
+			inc_sat = true;
+#endif
+#ifdef TRAIL
+			trail = true;
+#endif
+		}
+	};
+}
+
+#endif
@@ -0,0 +1,63 @@
+#ifndef STUCK_H
+#define STUCK_H
+
+#include <vector>
+
+namespace car
+{
+    /**
+     * @brief Whether the search is stuck at a level: the queries for it keep failing, and its frame does not block the states that come next.
+     * A level is stuck after `patience` failed queries with no state blocked by its frame in between, while the moving rate of failure is high.
+     * A failed query of the same state as the last one counts twice. Firing resets the count, so the extra effort at a level is paced by the patience.
+     */
+    class StuckDetector
+    {
+    public:
+        explicit StuckDetector(int patience, double min_fail_rate = 0.5) : patience_(patience), min_fail_rate_(min_fail_rate) {}
+
+        // a query for the level (the frame that gets the UC): whether it failed, and the state.
+        void query(int level, bool failed, int state_id)
+        {
+            Level &l = at(level);
+            l.fail_rate += ((failed ? 1.0 : 0.0) - l.fail_rate) * 0.0625;
+            if (failed)
+                l.streak += state_id == l.last_state ? 2 : 1;
+            l.last_state = state_id;
+        }
+
+        // a state was blocked by the frame of the level, without a query.
+        void blocked(int level) { at(level).streak = 0; }
+
+        // whether to spend extra effort on the level now.
+        bool stuck(int level)
+        {
+            if (patience_ <= 0)
+                return false;
+            Level &l = at(level);
+            if (l.streak < patience_ || l.fail_rate < min_fail_rate_)
+                return false;
+            l.streak = 0;
+            return true;
+        }
+
+    private:
+        struct Level
+        {
+            int streak = 0;
+            int last_state = -1;
+            double fail_rate = 0.0;
+        };
+        int patience_;
+        double min_fail_rate_;
+        std::vector<Level> levels_;
+
+        Level &at(int level)
+        {
+            if (levels_.size() <= level)
+                levels_.resize(level + 1);
+            return levels_[level];
+        }
+    };
+}
+
+#endif
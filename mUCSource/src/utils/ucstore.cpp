@@ -0,0 +1,69 @@
+#include "basic_data.h"
+#include <unordered_set>
+
+namespace car
+{
+	namespace
+	{
+		// the nodes are hashed and compared by their literals.
+		struct NodeHash
+		{
+			template <class N>
+			size_t operator()(const N *n) const
+			{
+				size_t h = n->lits.size();
+				for (int l : n->lits)
+					h = h * 1000003u ^ size_t(l);
+				return h;
+			}
+		};
+		struct NodeEq
+		{
+			template <class N>
+			bool operator()(const N *a, const N *b) const { return a->lits == b->lits; }
+		};
+	}
+
+	// NOTE: a function-local static, the frames of the static checkers may outlive a global one.
+	template <class N>
+	static std::unordered_set<N *, NodeHash, NodeEq> &store()
+	{
+		static std::unordered_set<N *, NodeHash, NodeEq> nodes;
+		return nodes;
+	}
+
+	static size_t peak = 0;
+
+	UC::Node *UC::intern(const Cube &cu)
+	{
+		Node probe{cu, 0, 0};
+		auto &nodes = store<Node>();
+		auto it = nodes.find(&probe);
+		if (it != nodes.end())
+		{
+			++(*it)->refs;
+			return *it;
+		}
+		Node *n = new Node{std::move(probe.lits), 1, 0};
+		nodes.insert(n);
+		if (nodes.size() > peak)
+			peak = nodes.size();
+		return n;
+	}
+
+	void UC::release(Node *n)
+	{
+		store<Node>().erase(n);
+		delete n;
+	}
+
+	size_t UC::store_size()
+	{
+		return store<Node>().size();
+	}
+
+	size_t UC::store_peak()
+	{
+		return peak;
+	}
+}
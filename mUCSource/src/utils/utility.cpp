@@ -2,6 +2,11 @@
 #include <vector>
 #include <algorithm>
 #include <unordered_set>
+#include <stdio.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 using namespace std;
 
 namespace car {
@@ -52,42 +57,42 @@ bool comp (int i, int j)
 
 //elements in v1, v2 are in order
 //check whether v2 is contained in v1 
-// bool imply(const std::vector<int>& v1, const std::vector<int>& v2, bool inorder)
-// {
-//     if (v1.size() < v2.size())
-//         return false;
-//     if(inorder)
-//     {
-//         if(v1.size() == v2.size())
-//             return v1 == v2;
-
-//         auto it1 = v1.begin(), it2 = v2.begin();
-//         const auto end1 = v1.end(), end2 = v2.end();
-
-//         while (it2 != end2) 
-//         {
-//             if (it1 == end1 || abs(*it2)<abs(*it1))
-//                 return false;
-//             else if (*it2 == *it1) 
-//                 ++it2;
-//             // for the last bit we added
-//             // if the prior last is not the conflicting lit,  we choose to keep the uc in.
-//             ++it1;
-//         }
-//     }
-//     else
-//     {
-//         // can be not in order now.
-//         std::unordered_set<int> marks;
-//         for(auto lit: v1)
-//             marks.insert(lit);
-//         for(auto lit: v2)
-//             if(marks.find(lit) == marks.end())
-//                 return false;
-//         marks.clear();
-//     }
-//     return true;
-// }
+bool imply(const std::vector<int>& v1, const std::vector<int>& v2, bool inorder)
+{
+    if (v1.size() < v2.size())
+        return false;
+    if(inorder)
+    {
+        if(v1.size() == v2.size())
+            return v1 == v2;
+
+        auto it1 = v1.begin(), it2 = v2.begin();
+        const auto end1 = v1.end(), end2 = v2.end();
+
+        while (it2 != end2) 
+        {
+            if (it1 == end1 || abs(*it2)<abs(*it1))
+                return false;
+            else if (*it2 == *it1) 
+                ++it2;
+            // for the last bit we added
+            // if the prior last is not the conflicting lit,  we choose to keep the uc in.
+            ++it1;
+        }
+    }
+    else
+    {
+        // can be not in order now.
+        std::unordered_set<int> marks;
+        for(auto lit: v1)
+            marks.insert(lit);
+        for(auto lit: v2)
+            if(marks.find(lit) == marks.end())
+                return false;
+        marks.clear();
+    }
+    return true;
+}
 
 
 std::vector<int> vec_intersect (const std::vector<int>& v1, const std::vector<int>& v2)
@@ -123,6 +128,47 @@ Cube negate(const Cube& cu)
     return res;
 }
 
+uint64_t hash_file (const std::string& file)
+{
+    int fd = open (file.c_str (), O_RDONLY);
+    if (fd < 0)
+        return 0;
+    struct stat st;
+    if (fstat (fd, &st) || st.st_size <= 0)
+    {
+        close (fd);
+        return 0;
+    }
+    size_t bytes = st.st_size;
+    void *start = mmap (NULL, bytes, PROT_READ, MAP_PRIVATE, fd, 0);
+    close (fd);
+    if (start == MAP_FAILED)
+        return 0;
+
+    uint64_t h = 14695981039346656037ULL;
+    const unsigned char *p = (const unsigned char *) start;
+    for (size_t i = 0; i < bytes; ++i)
+    {
+        h ^= p[i];
+        h *= 1099511628211ULL;
+    }
+    munmap (start, bytes);
+    return h;
+}
+
+long resident_memory_mb ()
+{
+    FILE *f = fopen ("/proc/self/statm", "r");
+    if (!f)
+        return 0;
+    long pages = 0, resident = 0;
+    int n = fscanf (f, "%ld %ld", &pages, &resident);
+    fclose (f);
+    if (n != 2)
+        return 0;
+    return resident * (sysconf (_SC_PAGESIZE) / 1024) / 1024;
+}
+
 // Cube minus(const Cube& c1, const Cube& c2)
 // {
 //     std::vector<int> res;
@@ -3,6 +3,8 @@
 
 #include "basic_data.h"
 #include <vector>
+#include <string>
+#include <cstdint>
 #include <iostream>
 #include <stdlib.h>
 #include <unordered_map>
@@ -25,7 +27,7 @@ void print (const std::unordered_map<int, std::vector<int> >& m);
 
 //elements in v1, v2 are in order
 //check whether v2 is contained in v1 
-// bool imply (const std::vector<int>& v1, const std::vector<int>& v2, bool inorder);
+bool imply (const std::vector<int>& v1, const std::vector<int>& v2, bool inorder);
 
 std::vector<int> vec_intersect (const std::vector<int>& v1, const std::vector<int>& v2);
 inline std::vector<int> cube_intersect (const std::vector<int>& v1, const std::vector<int>& v2)
@@ -35,6 +37,12 @@ inline std::vector<int> cube_intersect (const std::vector<int>& v1, const std::v
 
 bool comp (int i, int j);
 
+// FNV-1a hash of the whole content of a file, 0 if it cannot be read.
+uint64_t hash_file (const std::string& file);
+
+// resident memory of this process in MB, from /proc/self/statm. 0 if it cannot be read.
+long resident_memory_mb ();
+
 // my section
 
 Cube negate(const Cube& cu);